@@ -0,0 +1,93 @@
+#ifndef SCHEINERMAN_STREAM_STATIC_STREAM_H
+#define SCHEINERMAN_STREAM_STATIC_STREAM_H
+
+#include "StreamForward.h"
+#include "providers/Providers.h"
+
+#include <sstream>
+#include <string>
+
+namespace stream {
+
+template<typename T> class Operator;
+template<typename T> class Terminator;
+
+// A stream whose whole pipeline is known at compile time. Operators that
+// support it (map_, filter, peek, take_while, drop_while and the slicing
+// operators) nest their provider around this one by value, so no stage goes
+// through a virtual call. Any other operator, or converting to Stream<T>,
+// type-erases the pipeline built so far.
+template<typename P>
+class StaticStream {
+
+public:
+    using element_type = typename P::element_type;
+    using iterator = typename provider::StreamProvider<element_type>::Iterator;
+
+    explicit StaticStream(P&& provider)
+        : source_(std::move(provider)) {}
+
+    StaticStream(StaticStream<P>&& other) = default;
+    StaticStream<P>& operator= (StaticStream<P>&& other) = default;
+
+    StaticStream(const StaticStream<P>& other) = delete;
+    StaticStream<P>& operator= (const StaticStream<P>& other) = delete;
+
+    iterator begin() {
+        return source_.provider().begin();
+    }
+
+    iterator end() {
+        return source_.provider().end();
+    }
+
+    template<typename F>
+    auto operator| (Operator<F>&& op) ->
+            decltype(op.apply_to(std::move(*this))) {
+        return op.apply_to(std::move(*this));
+    }
+
+    template<typename F>
+    auto operator| (Operator<F>& op) ->
+            decltype(op.apply_to(std::move(*this))) {
+        return op.apply_to(std::move(*this));
+    }
+
+    template<typename F>
+    auto operator| (Terminator<F>&& term) ->
+            decltype(term.apply_to(std::move(*this))) {
+        return term.apply_to(std::move(*this));
+    }
+
+    template<typename F>
+    auto operator| (Terminator<F>& term) ->
+            decltype(term.apply_to(std::move(*this))) {
+        return term.apply_to(std::move(*this));
+    }
+
+    provider::Inline<P>& getSource() {
+        return source_;
+    }
+
+    std::string pipeline() {
+        std::stringstream ss;
+        provider::PrintInfo info = source_->print(ss, 1);
+        ss << "Static stream pipeline with "
+           << info.stages << " stage" << (info.stages == 1 ? "" : "s") << " and "
+           << info.sources << " source" << (info.sources == 1 ? "" : "s") << ".";
+        return ss.str();
+    }
+
+    template<typename> friend class Operator;
+    template<typename> friend class Terminator;
+
+private:
+    provider::Inline<P> source_;
+
+    void check_vacant(const std::string& method) {}
+
+};
+
+} /* namespace stream */
+
+#endif
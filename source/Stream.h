@@ -3,14 +3,21 @@
 
 #include "StreamForward.h"
 #include "StreamError.h"
+#include "StreamExecutor.h"
+#include "StreamRandom.h"
 #include "providers/Providers.h"
 #include "Utility.h"
 
 #include <unordered_set>
 #include <functional>
+#include <exception>
+#include <atomic>
+#include <thread>
+#include <mutex>
 #include <type_traits>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <vector>
 #include <random>
 #include <chrono>
@@ -104,6 +111,12 @@ struct MakeStream {
              typename ... GenArgs>
     static Stream<T> randoms(GenArgs&&... args);
 
+    template<typename T, template<typename> class Distribution,
+             typename Engine=random::Philox,
+             typename Seed,
+             typename ... GenArgs>
+    static Stream<T> counted_randoms(size_t count, Seed&& seed, GenArgs&&... args);
+
     template<typename Engine=std::default_random_engine, typename T>
     static Stream<T> uniform_random_ints(T lower, T upper);
 
@@ -146,6 +159,26 @@ struct MakeStream {
     template<typename Container>
     static Stream<ContainerType<Container>> from_move(Container&& cont);
 
+    template<typename Iterator>
+    static Stream<std::reference_wrapper<const IteratorType<Iterator>>>
+    view(Iterator begin, Iterator end);
+
+    template<typename Container>
+    static Stream<std::reference_wrapper<const ContainerType<Container>>>
+    view(const Container& cont);
+
+    template<typename Iterator>
+    static StaticStream<provider::Iterator<IteratorType<Iterator>, Iterator>>
+    static_from(Iterator begin, Iterator end);
+
+    template<typename Container>
+    static StaticStream<provider::Iterator<ContainerType<Container>,
+                                           decltype(std::begin(std::declval<const Container&>()))>>
+    static_from(const Container& cont);
+
+    template<typename T>
+    static StaticStream<provider::Iterator<T, T*>> static_from(T* array, std::size_t length);
+
 private:
     static auto default_seed() {
         return std::chrono::high_resolution_clock::now().time_since_epoch().count();
@@ -192,6 +225,10 @@ public:
     Stream(const Container& container)
         : Stream(container.begin(), container.end()) {}
 
+    template<typename P>
+    Stream(StaticStream<P>&& other)
+        : source_(std::move(other.getSource())) {}
+
     Stream(std::initializer_list<T> init)
         : Stream(std::deque<T>(init.begin(), init.end())) {}
 
@@ -268,9 +305,12 @@ private:
 
 } /* namespace stream */
 
+#include "StaticStream.h"
 #include "StreamOperations.h"
 #include "StreamOperators.h"
+#include "StreamParallelOperators.h"
 #include "StreamTerminators.h"
+#include "StreamParallelTerminators.h"
 #include "StreamGenerators.h"
 #include "StreamAlgebra.h"
 #include "StreamConversions.h"
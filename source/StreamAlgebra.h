@@ -3,6 +3,10 @@
 
 #include "Utility.h"
 
+// Operators between two streams zip them together. To compute both sides at
+// once, put each on its own thread first, as in
+// (left | op::async_buffer(n)) + (right | op::async_buffer(n)).
+
 #define STREAM_OP_STREAM(Op, Function) \
     template<typename T1, typename T2> \
     stream::Stream<std::result_of_t< Function (T1&&, T2&&)>> \
@@ -7,6 +7,15 @@ namespace op {
 
 namespace detail {
 
+template<typename Container>
+auto reserve(Container& container, size_t size, int)
+        -> decltype(container.reserve(size), void()) {
+    container.reserve(size);
+}
+
+template<typename Container>
+void reserve(Container& container, size_t size, long) {}
+
 template<template<typename T, typename A> class ListContainer>
 class ListContainerTerminatorMaker {
 
@@ -17,6 +26,7 @@ public:
         return make_terminator(name_, [](auto&& stream) {
             using T = StreamType<decltype(stream)>;
             ListContainer<T, std::allocator<T>> result;
+            reserve(result, stream.getSource()->size_hint(), 0);
             stream | copy_to(std::back_inserter(result));
             return result;
         });
@@ -27,6 +37,7 @@ public:
         return make_terminator(name_, [allocator](auto&& stream) {
             using T = StreamType<decltype(stream)>;
             ListContainer<T, Allocator> result(allocator);
+            reserve(result, stream.getSource()->size_hint(), 0);
             stream | copy_to(std::back_inserter(result));
             return result;
         });
@@ -67,13 +78,6 @@ private:
     std::string name_;
 };
 
-struct PolymorphicHash {
-    template<typename T>
-    decltype(auto) operator() (const T& value) {
-        return std::hash<T>{}(value);
-    }
-};
-
 template<template<typename T, typename H, typename P, typename A> class UnorderedContainer>
 class UnorderedContainerTerminatorMaker {
 
@@ -108,6 +112,40 @@ private:
     std::string name_;
 };
 
+// Builds the container from a ShardedSet made on the executor, so hashing
+// and, for sets, removing duplicates run in parallel. Only inserting the
+// results into the container is left for the calling thread.
+template<template<typename T, typename H, typename P, typename A> class UnorderedContainer,
+         bool Unique>
+class ParallelUnorderedContainerTerminatorMaker {
+
+public:
+    ParallelUnorderedContainerTerminatorMaker(const std::string& name) : name_(name) {}
+
+    template<typename Hash = PolymorphicHash,
+             typename Predicate = std::equal_to<void>>
+    auto operator() (const Hash& hash = Hash(),
+                     const Predicate& predicate = Predicate()) const {
+        return make_terminator(name_, exec::detail::on_executor(
+            [hash, predicate](auto&& stream, exec::Executor& executor) {
+                using T = StreamType<decltype(stream)>;
+                provider::ShardedSet<T, Hash, Predicate> set(hash, predicate, executor);
+                set.build(stream.getSource(), Unique);
+                UnorderedContainer<T, Hash, Predicate, std::allocator<T>>
+                    result(set.size(), hash, predicate);
+                for(auto& shard : set.shards()) {
+                    result.insert(std::make_move_iterator(shard.begin()),
+                                  std::make_move_iterator(shard.end()));
+                    std::vector<T>().swap(shard);
+                }
+                return result;
+            }));
+    }
+
+private:
+    std::string name_;
+};
+
 } /* namespace detail */
 
 static const detail::ListContainerTerminatorMaker<std::vector> to_vector{"stream::op::to_vector"};
@@ -117,6 +155,10 @@ static const detail::OrderedContainerTerminatorMaker<std::set> to_set{"stream::o
 static const detail::OrderedContainerTerminatorMaker<std::multiset> to_multiset{"stream::op::to_multiset"};
 static const detail::UnorderedContainerTerminatorMaker<std::unordered_set> to_unordered_set{"stream::op::to_unordered_set"};
 static const detail::UnorderedContainerTerminatorMaker<std::unordered_multiset> to_unordered_multiset{"stream::op::to_unordered_multiset"};
+static const detail::ParallelUnorderedContainerTerminatorMaker<std::unordered_set, true>
+    parallel_to_unordered_set{"stream::op::parallel_to_unordered_set"};
+static const detail::ParallelUnorderedContainerTerminatorMaker<std::unordered_multiset, false>
+    parallel_to_unordered_multiset{"stream::op::parallel_to_unordered_multiset"};
 
 } /* namespace op */
 
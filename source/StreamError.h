@@ -61,6 +61,24 @@ private:
     }
 };
 
+class SpillException : public StreamException {
+
+public:
+    explicit SpillException(const std::string& action)
+        : StreamException(build_message(action)) {}
+
+private:
+    static std::string build_message(const std::string& action) {
+        std::stringstream message;
+        message << "Could not " << action << " a temporary file for an external sort.";
+        return message.str();
+    }
+};
+
+// Kept for compatibility with code that ends its stream by throwing it.
+// Every stage treats it as the end of the stream; the function that threw
+// it produces nothing for the element it was working on. Prefer
+// request_stop(), which costs nothing until it is called.
 class StopStream : public StreamException {
 
 public:
@@ -68,6 +86,69 @@ public:
 
 };
 
+namespace detail {
+
+struct StopState {
+    bool requested = false;
+    size_t taken = 0;
+};
+
+inline StopState& stop_state() {
+    thread_local StopState state;
+    return state;
+}
+
+inline bool& stop_flag() {
+    return stop_state().requested;
+}
+
+// Returns whether a stop has been requested, clearing the request.
+inline bool take_stop_request() {
+    StopState& state = stop_state();
+    if(state.requested) {
+        state.requested = false;
+        state.taken++;
+        return true;
+    }
+    return false;
+}
+
+// How many requests this thread has taken so far. Parallel operations
+// compare it before and after running part of a stream on a worker to learn
+// whether that part was stopped.
+inline size_t stops_taken() {
+    return stop_state().taken;
+}
+
+// Stages that advance a nested stream call this afterwards with the count
+// from before. If the nested stream was stopped, the request is raised
+// again so the stage's own stream ends too, and true is returned.
+inline bool relay_stop(size_t stops_before) {
+    if(stops_taken() == stops_before) {
+        return false;
+    }
+    stop_flag() = true;
+    return true;
+}
+
+} /* namespace detail */
+
+// Ends the stream from inside a function passed to one of its operations.
+// The call that requests the stop is the last one: its result still counts,
+// so a map_ still emits the element it returned, a filter still keeps the
+// element if it returned true, and for_each or reduce still include the
+// element they were given, but nothing after it is pulled.
+//
+// The request is seen by whichever stage called the function on the thread
+// it was called on. The parallel operations pass a stop from their workers
+// on: parallel_map, parallel_filter and parallel_flat_map hand out nothing
+// after the chunk that stopped, and the parallel terminators leave out
+// every part of the stream after the one that stopped. Parts before it that
+// other workers were already handling still count in full.
+inline void request_stop() {
+    detail::stop_flag() = true;
+}
+
 } /* namespace stream */
 
 #endif
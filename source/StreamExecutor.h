@@ -0,0 +1,347 @@
+#ifndef SCHEINERMAN_STREAM_STREAM_EXECUTOR_H
+#define SCHEINERMAN_STREAM_STREAM_EXECUTOR_H
+
+#include "StreamError.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace stream {
+namespace exec {
+
+// Runs the tasks of parallel stream operations. Tasks must not throw.
+class Executor {
+
+public:
+    virtual ~Executor() = default;
+
+    virtual void submit(std::function<void()> task) = 0;
+
+    // How many tasks the executor can usefully run at once.
+    virtual size_t concurrency() const = 0;
+
+};
+
+// A fixed set of worker threads, each with its own deque of tasks. Workers
+// push and pop their own tasks at the back and steal from the front of the
+// others' deques when they run dry. Tasks submitted from outside the pool
+// are dealt out round robin. With pin set, each worker is bound to one CPU
+// where the platform supports it.
+class ThreadPool : public Executor {
+
+public:
+    explicit ThreadPool(size_t threads = 0, bool pin = false) {
+        if(threads == 0) {
+            threads = std::thread::hardware_concurrency();
+            threads = threads == 0 ? 1 : threads;
+        }
+        for(size_t i = 0; i < threads; i++) {
+            workers_.emplace_back(new Worker);
+        }
+        for(size_t i = 0; i < threads; i++) {
+            threads_.emplace_back([this, i] { run(i); });
+            if(pin) {
+                pin_thread(threads_.back(), i);
+            }
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator= (const ThreadPool&) = delete;
+
+    // Finishes every task already submitted, then joins the workers.
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for(auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void submit(std::function<void()> task) override {
+        auto& current = current_worker();
+        size_t index = current.pool == this
+            ? current.index
+            : next_++ % workers_.size();
+        {
+            std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+            workers_[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_++;
+        }
+        wake_.notify_one();
+    }
+
+    size_t concurrency() const override {
+        return workers_.size();
+    }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    struct WorkerSlot {
+        const ThreadPool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    size_t pending_ = 0;
+    bool stopping_ = false;
+    std::atomic<size_t> next_{0};
+
+    static WorkerSlot& current_worker() {
+        thread_local WorkerSlot slot;
+        return slot;
+    }
+
+    static void pin_thread(std::thread& thread, size_t index) {
+#if defined(__linux__)
+        size_t cpus = std::thread::hardware_concurrency();
+        if(cpus == 0) {
+            return;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(index % cpus, &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+        (void) thread;
+        (void) index;
+#endif
+    }
+
+    // Pops from the back of worker index, or else steals from the front of
+    // the first other worker that has something.
+    bool take(size_t index, std::function<void()>& task) {
+        size_t count = workers_.size();
+        for(size_t offset = 0; offset < count; offset++) {
+            Worker& worker = *workers_[(index + offset) % count];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if(worker.tasks.empty()) {
+                continue;
+            }
+            if(offset == 0) {
+                task = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+            } else {
+                task = std::move(worker.tasks.front());
+                worker.tasks.pop_front();
+            }
+            std::lock_guard<std::mutex> pending_lock(mutex_);
+            pending_--;
+            return true;
+        }
+        return false;
+    }
+
+    void run(size_t index) {
+        current_worker() = {this, index};
+        std::function<void()> task;
+        while(true) {
+            if(take(index, task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || pending_ > 0; });
+            if(stopping_ && pending_ == 0) {
+                return;
+            }
+        }
+    }
+
+};
+
+// The pool parallel operations run on unless they are given another
+// executor, sized to the hardware and shared by every pipeline.
+inline Executor& default_executor() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// Tracks a set of tasks submitted to an executor so they can be waited on
+// together. The first exception thrown by any of them is rethrown by wait().
+//
+// The tasks are queued on the group itself, and what goes to the executor
+// only runs whichever of them is next. A thread waiting on the group runs
+// the group's tasks that have not started yet, so nested groups cannot
+// starve the pool, and it never picks up unrelated tasks that might block.
+class TaskGroup {
+
+public:
+    explicit TaskGroup(Executor& executor)
+        : executor_(executor), state_(std::make_shared<State>()) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator= (const TaskGroup&) = delete;
+
+    ~TaskGroup() {
+        try {
+            wait();
+        } catch(...) {}
+    }
+
+    template<typename Task>
+    void run(Task&& task) {
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->queued.emplace_back(std::forward<Task>(task));
+            state_->outstanding++;
+        }
+        // Wakes a waiter, which may have nothing of its own left to run.
+        state_->changed.notify_all();
+        // Holds on to the state, which may outlive the group when the
+        // waiting thread has already run the task this was meant for.
+        std::shared_ptr<State> state = state_;
+        executor_.submit([state] { state->run_next(); });
+    }
+
+    // Runs one of the group's tasks that has not started yet on the calling
+    // thread. Returns false if there was none.
+    bool run_pending() {
+        return state_->run_next();
+    }
+
+    // Drops the group's tasks that have not started yet. Tasks that are
+    // already running carry on, and wait() still waits for them.
+    void cancel() {
+        std::deque<std::function<void()>> cancelled;
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            cancelled.swap(state_->queued);
+            state_->outstanding -= cancelled.size();
+        }
+        state_->changed.notify_all();
+    }
+
+    // Blocks until every task has run, running the group's own queued tasks
+    // on this thread in the meantime.
+    void wait() {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        while(state_->outstanding > 0) {
+            if(state_->queued.empty()) {
+                state_->changed.wait(lock);
+                continue;
+            }
+            lock.unlock();
+            state_->run_next();
+            lock.lock();
+        }
+        if(state_->error) {
+            std::exception_ptr error = state_->error;
+            state_->error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    Executor& executor() {
+        return executor_;
+    }
+
+private:
+    struct State {
+        std::mutex mutex;
+        // Notified when a task is queued or cancelled and when the last one
+        // finishes.
+        std::condition_variable changed;
+        std::deque<std::function<void()>> queued;
+        size_t outstanding = 0;
+        std::exception_ptr error;
+
+        bool run_next() {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(queued.empty()) {
+                    return false;
+                }
+                task = std::move(queued.front());
+                queued.pop_front();
+            }
+            try {
+                task();
+            } catch(...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(!error) {
+                    error = std::current_exception();
+                }
+            }
+            task = nullptr;
+            // A stop request the task left behind must not leak into
+            // whatever this thread runs next.
+            stream::detail::stop_flag() = false;
+            std::lock_guard<std::mutex> lock(mutex);
+            if(--outstanding == 0) {
+                changed.notify_all();
+            }
+            return true;
+        }
+    };
+
+    Executor& executor_;
+    std::shared_ptr<State> state_;
+
+};
+
+namespace detail {
+
+// Wraps the function behind a parallel operator or terminator so it is
+// called with the executor to run on, which on() can change.
+template<typename F>
+class OnExecutor {
+
+public:
+    explicit OnExecutor(F&& function) : function_(std::move(function)) {}
+
+    template<typename S>
+    auto operator() (S&& stream) {
+        return function_(std::forward<S>(stream),
+                         executor_ ? *executor_ : default_executor());
+    }
+
+    void set_executor(Executor& executor) {
+        executor_ = &executor;
+    }
+
+private:
+    F function_;
+    Executor* executor_ = nullptr;
+
+};
+
+template<typename F>
+OnExecutor<F> on_executor(F&& function) {
+    return OnExecutor<F>(std::forward<F>(function));
+}
+
+} /* namespace detail */
+
+} /* namespace exec */
+} /* namespace stream */
+
+#endif
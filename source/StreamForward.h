@@ -6,11 +6,15 @@
 namespace stream {
 
 template<typename T> class Stream;
+template<typename P> class StaticStream;
 
 namespace detail {
 
 template<typename T> struct StreamIdentifier { using type = void; };
 template<typename T> struct StreamIdentifier<Stream<T>> { using type = T; };
+template<typename P> struct StreamIdentifier<StaticStream<P>> {
+    using type = typename P::element_type;
+};
 
 } /* namespace detail */
 
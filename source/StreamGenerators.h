@@ -8,6 +8,64 @@ namespace detail {
 template<template<typename> class Distribution, typename Engine, typename T>
 struct RandomGenerator;
 
+// Counter-based engines get a provider that can seek and split; any other
+// engine is simply called from a generator.
+template<typename T, template<typename> class Distribution, typename Engine,
+         typename Seed, typename... GenArgs>
+Stream<T> make_randoms(std::true_type, Seed seed, GenArgs&&... args) {
+    return StreamProviderPtr<T>(new provider::Randoms<T, Distribution, Engine>(
+        Engine(static_cast<std::uint64_t>(seed)),
+        Distribution<T>(std::forward<GenArgs>(args)...)));
+}
+
+template<typename T, template<typename> class Distribution, typename Engine,
+         typename Seed, typename... GenArgs>
+Stream<T> make_randoms(std::false_type, Seed seed, GenArgs&&... args) {
+    return MakeStream::generate(RandomGenerator<Distribution, Engine, T>
+        (seed, std::forward<GenArgs>(args)...));
+}
+
+// Integer ranges with a positive step have a length that is known up front,
+// so they get a Range provider. Anything else, including ranges that would
+// never end, returns nullptr and keeps the general counter-based path.
+template<typename T, typename U>
+StreamProviderPtr<T> counted_range(const T& lower, const T& upper, const U& increment,
+                                   bool closed, std::true_type) {
+    if(!(increment > 0)) {
+        return nullptr;
+    }
+    size_t count = 0;
+    if(lower < upper || (closed && lower == upper)) {
+        size_t span = static_cast<size_t>(upper) - static_cast<size_t>(lower);
+        count = (closed ? span : span - 1) / static_cast<size_t>(increment) + 1;
+    }
+    return StreamProviderPtr<T>(
+        new provider::Range<T>(lower, static_cast<T>(increment), count));
+}
+
+template<typename T, typename U>
+StreamProviderPtr<T> counted_range(const T&, const T&, const U&, bool, std::false_type) {
+    return nullptr;
+}
+
+template<typename T, typename U>
+StreamProviderPtr<T> counted_range(const T& lower, const T& upper, const U& increment,
+                                   bool closed) {
+    using Countable = std::integral_constant<bool,
+        std::is_integral<T>::value && std::is_integral<U>::value>;
+    return counted_range(lower, upper, increment, closed, Countable{});
+}
+
+template<typename T>
+StreamProviderPtr<T> counter(const T& start, std::true_type) {
+    return StreamProviderPtr<T>(new provider::Range<T>(start, 1));
+}
+
+template<typename T>
+StreamProviderPtr<T> counter(const T& start, std::false_type) {
+    return nullptr;
+}
+
 } /* namespace detail */
 
 template<typename T>
@@ -122,6 +180,9 @@ Stream<RemoveRef<Head<Args...>>> MakeStream::recurrence(Function&& function, Arg
 template<typename T>
 Stream<RemoveRef<T>> MakeStream::counter(T&& start) {
     using R = RemoveRef<T>;
+    if(auto counted = detail::counter<R>(start, std::is_integral<R>{})) {
+        return counted;
+    }
     return MakeStream::iterate(std::forward<T>(start), [](R value) {
             return ++value;
         });
@@ -148,6 +209,9 @@ Stream<RemoveRef<T>> MakeStream::counter(T&& start, const U& increment) {
 template<typename T>
 Stream<RemoveRef<T>> MakeStream::range(T&& lower, T&& upper) {
     using R = RemoveRef<T>;
+    if(auto counted = detail::counted_range<R>(lower, upper, 1, false)) {
+        return counted;
+    }
     return MakeStream::counter(lower)
         | op::take_while([upper = std::forward<T>(upper)](const R& value) {
             return value != upper;
@@ -157,6 +221,9 @@ Stream<RemoveRef<T>> MakeStream::range(T&& lower, T&& upper) {
 template<typename T, typename U>
 Stream<RemoveRef<T>> MakeStream::range(T&& lower, T&& upper, U&& increment) {
     using R = RemoveRef<T>;
+    if(auto counted = detail::counted_range<R>(lower, upper, increment, false)) {
+        return counted;
+    }
     return MakeStream::counter(lower, std::forward<U>(increment))
         | op::take_while([upper = std::forward<T>(upper)](const R& value) {
             return value < upper;
@@ -166,6 +233,9 @@ Stream<RemoveRef<T>> MakeStream::range(T&& lower, T&& upper, U&& increment) {
 template<typename T, typename U>
 Stream<RemoveRef<T>> MakeStream::range(T&& lower, T&& upper, const U& increment) {
     using R = RemoveRef<T>;
+    if(auto counted = detail::counted_range<R>(lower, upper, increment, false)) {
+        return counted;
+    }
     return MakeStream::counter(lower, increment)
         | op::take_while([upper = std::forward<T>(upper)](const R& value) {
             return value < upper;
@@ -175,6 +245,9 @@ Stream<RemoveRef<T>> MakeStream::range(T&& lower, T&& upper, const U& increment)
 template<typename T>
 Stream<RemoveRef<T>> MakeStream::closed_range(T&& lower, T&& upper) {
     using R = RemoveRef<T>;
+    if(auto counted = detail::counted_range<R>(lower, upper, 1, true)) {
+        return counted;
+    }
     return MakeStream::counter(lower)
         | op::take_while([upper = std::forward<T>(upper)](R& value) {
             return value <= upper;
@@ -184,6 +257,9 @@ Stream<RemoveRef<T>> MakeStream::closed_range(T&& lower, T&& upper) {
 template<typename T, typename U>
 Stream<RemoveRef<T>> MakeStream::closed_range(T&& lower, T&& upper, U&& increment) {
     using R = RemoveRef<T>;
+    if(auto counted = detail::counted_range<R>(lower, upper, increment, true)) {
+        return counted;
+    }
     return MakeStream::counter(lower, std::forward<U>(increment))
         | op::take_while([upper = std::forward<T>(upper)](R& value) {
             return value <= upper;
@@ -193,6 +269,9 @@ Stream<RemoveRef<T>> MakeStream::closed_range(T&& lower, T&& upper, U&& incremen
 template<typename T, typename U>
 Stream<RemoveRef<T>> MakeStream::closed_range(T&& lower, T&& upper, const U& increment) {
     using R = RemoveRef<T>;
+    if(auto counted = detail::counted_range<R>(lower, upper, increment, true)) {
+        return counted;
+    }
     return MakeStream::counter(lower, increment)
         | op::take_while([upper = std::forward<T>(upper)](R& value) {
             return value <= upper;
@@ -205,8 +284,8 @@ template<typename T,
          typename Seed,
          typename... GenArgs>
 Stream<T> MakeStream::randoms_seeded(Seed&& seed, GenArgs&&... args) {
-    return generate(detail::RandomGenerator<Distribution, Engine, T>
-        (seed, std::forward<GenArgs>(args)...));
+    return detail::make_randoms<T, Distribution, Engine>(
+        random::is_counter_based<Engine>(), seed, std::forward<GenArgs>(args)...);
 }
 
 template<typename T,
@@ -218,6 +297,19 @@ Stream<T> MakeStream::randoms(GenArgs&&... args) {
         (default_seed(), std::forward<GenArgs>(args)...);
 }
 
+template<typename T,
+         template<typename> class Distribution,
+         typename Engine,
+         typename Seed,
+         typename... GenArgs>
+Stream<T> MakeStream::counted_randoms(size_t count, Seed&& seed, GenArgs&&... args) {
+    static_assert(random::is_counter_based<Engine>::value,
+        "Counted random streams need a counter-based engine.");
+    return StreamProviderPtr<T>(new provider::Randoms<T, Distribution, Engine>(
+        Engine(static_cast<std::uint64_t>(seed)),
+        Distribution<T>(std::forward<GenArgs>(args)...), count));
+}
+
 template<typename Engine, typename T>
 Stream<T> MakeStream::uniform_random_ints(T lower, T upper) {
     return uniform_random_ints<Engine, T>(lower, upper, default_seed());
@@ -283,6 +375,20 @@ Stream<ContainerType<Container>> MakeStream::from(const Container& cont) {
     return {std::begin(cont), std::end(cont)};
 }
 
+template<typename Iterator>
+Stream<std::reference_wrapper<const IteratorType<Iterator>>>
+MakeStream::view(Iterator begin, Iterator end) {
+    using T = IteratorType<Iterator>;
+    return StreamProviderPtr<std::reference_wrapper<const T>>(
+        new provider::View<T, Iterator>(begin, end));
+}
+
+template<typename Container>
+Stream<std::reference_wrapper<const ContainerType<Container>>>
+MakeStream::view(const Container& cont) {
+    return MakeStream::view(std::begin(cont), std::end(cont));
+}
+
 template<typename Container>
 Stream<ContainerType<Container>> MakeStream::from_move(Container&& cont) {
     using T = ContainerType<Container>;
@@ -296,6 +402,25 @@ Stream<T> MakeStream::from(std::initializer_list<T> init) {
         (Container(init), 1);
 }
 
+template<typename Iterator>
+StaticStream<provider::Iterator<IteratorType<Iterator>, Iterator>>
+MakeStream::static_from(Iterator begin, Iterator end) {
+    using Provider = provider::Iterator<IteratorType<Iterator>, Iterator>;
+    return StaticStream<Provider>(Provider(begin, end));
+}
+
+template<typename Container>
+StaticStream<provider::Iterator<ContainerType<Container>,
+                                decltype(std::begin(std::declval<const Container&>()))>>
+MakeStream::static_from(const Container& cont) {
+    return MakeStream::static_from(std::begin(cont), std::end(cont));
+}
+
+template<typename T>
+StaticStream<provider::Iterator<T, T*>> MakeStream::static_from(T* array, std::size_t length) {
+    return MakeStream::static_from(array, array + length);
+}
+
 namespace detail {
 
 template<template<typename> class Distribution, typename Engine, typename T>
@@ -8,9 +8,9 @@ class Compose {
 public:
     Compose(F&& f, G&& g) : f_(std::forward<F>(f)), g_(std::forward<G>(g)) {}
 
-    template<typename T>
-    std::result_of_t<F(std::result_of_t<G(Stream<T>&&)>)> operator() (Stream<T>&& stream) {
-        return f_(g_(std::forward<Stream<T>>(stream)));
+    template<typename S>
+    std::result_of_t<F(std::result_of_t<G(S&&)>)> operator() (S&& stream) {
+        return f_(g_(std::forward<S>(stream)));
     }
 
 private:
@@ -24,12 +24,12 @@ public:
     Operator(const std::string& name, F&& op) : name_(name), operator_(std::forward<F>(op)) {}
     Operator(F&& op) : operator_(std::forward<F>(op)) {}
 
-    template<typename T>
-    std::result_of_t<F(Stream<T>&&)> apply_to(Stream<T>&& stream)  {
+    template<typename S>
+    std::result_of_t<F(S&&)> apply_to(S&& stream)  {
         if(!name_.empty()) {
             stream.check_vacant(name_);
         }
-        return operator_(std::forward<Stream<T>>(stream));
+        return operator_(std::forward<S>(stream));
     }
 
     template<typename G>
@@ -47,6 +47,12 @@ public:
         return std::move(*this);
     }
 
+    // Runs a parallel operator on executor instead of the default pool.
+    Operator<F> on(exec::Executor& executor) && {
+        operator_.set_executor(executor);
+        return std::move(*this);
+    }
+
     template<typename> friend class Operator;
 private:
     std::string name_;
@@ -60,13 +66,16 @@ public:
     Terminator(const std::string& name, F&& term) : name_(name), terminator_(term) {}
     Terminator(F&& term) : terminator_(term) {}
 
-    template<typename T>
-    auto apply_to(Stream<T>&& stream) -> std::result_of_t<F(Stream<T>&&)> {
+    template<typename S>
+    auto apply_to(S&& stream) -> std::result_of_t<F(S&&)> {
         if(!name_.empty()) {
             stream.check_vacant(name_);
         }
+        // Drop a request left over from a pipeline that ended without
+        // seeing it.
+        stream::detail::take_stop_request();
         try {
-            return terminator_(std::forward<Stream<T>>(stream));
+            return terminator_(std::forward<S>(stream));
         } catch(EmptyStreamException& e) {
             if(!name_.empty()) {
                 throw EmptyStreamException(name_);
@@ -74,7 +83,6 @@ public:
                 throw;
             }
         }
-        stream.close();
     }
 
     Terminator<F> rename(const std::string& name) && {
@@ -82,6 +90,12 @@ public:
         return std::move(*this);
     }
 
+    // Runs a parallel terminator on executor instead of the default pool.
+    Terminator<F> on(exec::Executor& executor) && {
+        terminator_.set_executor(executor);
+        return std::move(*this);
+    }
+
     template<typename G>
     Terminator<Compose<G, F>> then(G&& function) {
         return {Compose<G, F>(std::forward<G>(function), std::move(terminator_))};
@@ -12,13 +12,51 @@ namespace op {
     template<typename R, typename C> auto operation (R (C::*member)() const) \
         { return operation (std::mem_fn(member)); }
 
+namespace detail {
+
+template<template<typename...> class Provider,
+         typename T,
+         typename... TemplateArgs,
+         typename In,
+         typename... ConstructorArgs>
+Stream<T> make_stage(Stream<In>&& stream, ConstructorArgs&&... args) {
+    return make_stream_provider<Provider, T, TemplateArgs...>(
+        std::move(stream.getSource()), std::forward<ConstructorArgs>(args)...);
+}
+
+template<template<typename...> class Provider,
+         typename T,
+         typename... TemplateArgs,
+         typename P,
+         typename... ConstructorArgs>
+StaticStream<Provider<T, TemplateArgs..., provider::Inline<P>>>
+make_stage(StaticStream<P>&& stream, ConstructorArgs&&... args) {
+    using Stage = Provider<T, TemplateArgs..., provider::Inline<P>>;
+    return StaticStream<Stage>(Stage(std::move(stream.getSource()),
+                                     std::forward<ConstructorArgs>(args)...));
+}
+
+// A sort directly upstream of a stage that reads no more than its first
+// count elements only has to find those.
+template<typename T>
+void keep_first(StreamProviderPtr<T>& source, size_t count) {
+    if(auto sort = dynamic_cast<provider::SortBase<T>*>(source.get())) {
+        sort->keep_first(count);
+    }
+}
+
+// Static streams never contain a sort.
+template<typename Source>
+void keep_first(Source&, size_t) {}
+
+} /* namespace detail */
+
 template<typename Predicate>
 inline auto filter(Predicate&& predicate) {
     return make_operator("stream::op::filter", [=](auto&& stream) mutable {
         using T = StreamType<decltype(stream)>;
-        return Stream<T>(std::move(
-            make_stream_provider<provider::Filter, T, Predicate>(
-                std::move(stream.getSource()), std::forward<Predicate>(predicate))));
+        return detail::make_stage<provider::Filter, T, Predicate>(
+            std::move(stream), std::forward<Predicate>(predicate));
     });
 }
 
@@ -32,9 +70,8 @@ template<typename Predicate>
 inline auto take_while(Predicate&& predicate) {
     return make_operator("stream::op::take_while", [=](auto&& stream) mutable {
         using T = StreamType<decltype(stream)>;
-        return Stream<T>(std::move(
-            make_stream_provider<provider::TakeWhile, T, Predicate>
-                (std::move(stream.getSource()), std::forward<Predicate>(predicate))));
+        return detail::make_stage<provider::TakeWhile, T, Predicate>(
+            std::move(stream), std::forward<Predicate>(predicate));
     });
 }
 
@@ -48,9 +85,8 @@ template<typename Predicate>
 inline auto drop_while(Predicate&& predicate) {
     return make_operator("stream::op::drop_while", [=](auto&& stream) mutable {
         using T = StreamType<decltype(stream)>;
-        return Stream<T>(std::move(
-            make_stream_provider<provider::DropWhile, T, Predicate>(
-                std::move(stream.getSource()), std::forward<Predicate>(predicate))));
+        return detail::make_stage<provider::DropWhile, T, Predicate>(
+            std::move(stream), std::forward<Predicate>(predicate));
     });
 }
 
@@ -63,18 +99,17 @@ CLASS_SPECIALIZATIONS(drop_while);
 inline auto slice(std::size_t start, std::size_t end, std::size_t increment = 1) {
     return make_operator("stream::op::slice", [=](auto&& stream) {
         using T = StreamType<decltype(stream)>;
-        return Stream<T>(std::move(
-            make_stream_provider<provider::Slice, T>(
-                std::move(stream.getSource()), start, end, increment, false)));
+        detail::keep_first(stream.getSource(), end);
+        return detail::make_stage<provider::Slice, T>(
+            std::move(stream), start, end, increment, false);
     });
 }
 
 inline auto slice_to_end(std::size_t start, std::size_t increment) {
     return make_operator("stream::op::slice", [=](auto&& stream) {
         using T = StreamType<decltype(stream)>;
-        return Stream<T>(std::move(
-            make_stream_provider<provider::Slice, T>(
-                std::move(stream.getSource()), start, 0, increment, true)));
+        return detail::make_stage<provider::Slice, T>(
+            std::move(stream), start, 0, increment, true);
     });
 }
 
@@ -94,9 +129,8 @@ inline auto map_(Function&& function) {
         static_assert(!std::is_void<Result>::value,
             "Return type of the mapping function cannot be void.");
 
-        return Stream<Result>(std::move(
-            make_stream_provider<provider::Map, Result, Function, T>(
-                std::move(stream.getSource()), std::forward<Function>(function))));
+        return detail::make_stage<provider::Map, Result, Function, T>(
+            std::move(stream), std::forward<Function>(function));
     });
 }
 
@@ -106,9 +140,8 @@ template<typename Action>
 inline auto peek(Action&& action) {
     return make_operator("stream::op::peek", [=](auto&& stream) mutable {
         using T = StreamType<decltype(stream)>;
-        return Stream<T>(std::move(
-            make_stream_provider<provider::Peek, T, Action>(
-                std::move(stream.getSource()), std::forward<Action>(action))));
+        return detail::make_stage<provider::Peek, T, Action>(
+            std::move(stream), std::forward<Action>(action));
     });
 }
 
@@ -164,17 +197,18 @@ inline auto partial_sum(Adder&& add = Adder()) {
 
 template<typename U>
 inline auto concat(Stream<U>&& tail) {
-    return make_operator("stream::op::concat", [tail = std::move(tail)] (auto&& head) mutable {
+    return make_operator("stream::op::concat", [tail = std::move(tail)] (auto&& stream) mutable {
         if(!tail.occupied())
             throw VacantStreamException("stream::op::concat");
-        using T = StreamType<decltype(head)>;
+        using T = StreamType<decltype(stream)>;
         static_assert(std::is_same<T, U>::value,
             "Cannot concatenate streams with different types.");
 
+        Stream<T> head = std::move(stream);
         auto concat_ptr = dynamic_cast<provider::Concatenate<T>*>(head.getSource().get());
         if(concat_ptr) {
             concat_ptr->concat(std::move(tail.getSource()));
-            return std::move(head);
+            return head;
         }
         return Stream<T>(std::move(
             make_stream_provider<provider::Concatenate, T>(
@@ -236,9 +270,28 @@ inline auto overlap(size_t N) {
     });
 }
 
-template<typename R, typename Function = provider::detail::Zipper>
-inline auto zip_with(Stream<R>&& right, Function&& zipper = Function()) {
-    return make_operator("stream::op::zip_with", [right = std::move(right), zipper]
+namespace detail {
+
+// Moves a zip's source onto a thread of its own with a queue of the given
+// size, or leaves it alone when the size is 0.
+template<typename T>
+StreamProviderPtr<T> prefetched(StreamProviderPtr<T>&& source, size_t prefetch) {
+    if(prefetch == 0) {
+        return std::move(source);
+    }
+    return make_stream_provider<provider::AsyncBuffer, T>(std::move(source), prefetch);
+}
+
+} /* namespace detail */
+
+// With a prefetch size, the left and right streams are each driven on a
+// thread of their own, staying up to that many elements ahead, so two
+// expensive independent sources cost about as much as the slower of them
+// rather than both together. Either side may then be read a few elements
+// past the end of the other.
+template<typename R, typename Function>
+inline auto zip_with(Stream<R>&& right, Function&& zipper, size_t prefetch) {
+    return make_operator("stream::op::zip_with", [right = std::move(right), zipper, prefetch]
     (auto&& left) mutable {
         if(!right.occupied())
             throw VacantStreamException("stream::op::zip_with");
@@ -250,11 +303,23 @@ inline auto zip_with(Stream<R>&& right, Function&& zipper = Function()) {
 
         return Stream<Result>(std::move(StreamProviderPtr<Result>(
             new provider::Zip<L, R, Function>(
-                std::move(left.getSource()), std::move(right.getSource()),
+                detail::prefetched(std::move(left.getSource()), prefetch),
+                detail::prefetched(std::move(right.getSource()), prefetch),
                 std::forward<Function>(zipper)))));
     });
 }
 
+template<typename R, typename Function = provider::detail::Zipper,
+         typename = std::enable_if_t<!std::is_integral<std::decay_t<Function>>::value>>
+inline auto zip_with(Stream<R>&& right, Function&& zipper = Function()) {
+    return zip_with(std::move(right), std::forward<Function>(zipper), 0);
+}
+
+template<typename R>
+inline auto zip_with(Stream<R>&& right, size_t prefetch) {
+    return zip_with(std::move(right), provider::detail::Zipper(), prefetch);
+}
+
 namespace detail {
 
 template<template<typename...> class Provider, typename T, typename Less>
@@ -313,12 +378,68 @@ inline auto state_point() {
     });
 }
 
+// Splits the stream into n streams that each see every element. Elements
+// are kept only until the slowest of them has read them, so the branches
+// can be read one after another, or on different threads at once. With a
+// capacity the buffer stays bounded: a branch that gets that far ahead
+// waits for the others, so each branch then needs a thread of its own.
+inline auto tee(size_t n, size_t capacity = 0) {
+    return make_operator("stream::op::tee", [=](auto&& stream) {
+        using T = StreamType<decltype(stream)>;
+        auto buffer = std::make_shared<provider::TeeBuffer<T>>(
+            std::move(stream.getSource()), n, capacity);
+        std::vector<Stream<T>> branches;
+        for(size_t i = 0; i < n; i++) {
+            branches.emplace_back(make_stream_provider<provider::Tee, T>(buffer, i));
+        }
+        return branches;
+    });
+}
+
+// Numbers sorted with std::less are radix sorted; anything else is sorted
+// with std::sort.
 template<typename Less = std::less<void>>
 inline auto sort(Less&& less = Less()) {
     return make_operator("stream::op::sort", [=](auto&& stream) mutable {
         using T = StreamType<decltype(stream)>;
-        return Stream<T>(std::move(
-            make_stream_provider<provider::Sort, T, Less>(
+        return Stream<T>(StreamProviderPtr<T>(
+            new provider::Sort<T, Less>(
+                std::move(stream.getSource()), std::forward<Less>(less))));
+    });
+}
+
+// The k smallest elements in order. The same as sort followed by limit(k),
+// which is turned into this, but holding only about 2k elements at once.
+template<typename Less = std::less<void>>
+inline auto top_k(size_t k, Less&& less = Less()) {
+    return make_operator("stream::op::top_k", [=](auto&& stream) mutable {
+        using T = StreamType<decltype(stream)>;
+        return Stream<T>(StreamProviderPtr<T>(
+            new provider::Sort<T, Less>(
+                std::move(stream.getSource()), std::forward<Less>(less), k)));
+    });
+}
+
+// Like sort, but holding only about memory_budget bytes of elements at a
+// time: sorted runs of that size are spilled to temporary files and merged
+// as the stream is read. Elements must be trivially copyable or strings,
+// unless provider::SpillCodec is specialized for them.
+template<typename Less = std::less<void>>
+inline auto external_sort(size_t memory_budget, Less&& less = Less()) {
+    return make_operator("stream::op::external_sort", [=](auto&& stream) mutable {
+        using T = StreamType<decltype(stream)>;
+        return Stream<T>(make_stream_provider<provider::ExternalSort, T, Less>(
+            std::move(stream.getSource()), std::forward<Less>(less), memory_budget));
+    });
+}
+
+// Like sort, but elements that compare equal keep their order.
+template<typename Less = std::less<void>>
+inline auto stable_sort(Less&& less = Less()) {
+    return make_operator("stream::op::stable_sort", [=](auto&& stream) mutable {
+        using T = StreamType<decltype(stream)>;
+        return Stream<T>(StreamProviderPtr<T>(
+            new provider::Sort<T, Less, true>(
                 std::move(stream.getSource()), std::forward<Less>(less))));
     });
 }
@@ -333,6 +454,48 @@ inline auto distinct(Less&& less = Less()) {
     });
 }
 
+// Removes duplicate elements by hash, passing each on the first time it is
+// seen, so unlike distinct it keeps stream order and works on infinite
+// streams. Elements must be copyable.
+template<typename Hash = PolymorphicHash, typename Equal = std::equal_to<void>>
+inline auto distinct_unordered(const Hash& hash = Hash(), const Equal& equal = Equal()) {
+    return make_operator("stream::op::distinct_unordered", [=](auto&& stream) {
+        using T = StreamType<decltype(stream)>;
+        return Stream<T>(make_stream_provider<provider::DistinctUnordered, T, Hash, Equal>(
+            std::move(stream.getSource()), hash, equal));
+    });
+}
+
+// Sorts by the key key_fn gives each element, calling it once per element.
+// Elements with equal keys keep their order.
+template<typename KeyFn, typename Less = std::less<void>>
+inline auto sort_by(KeyFn&& key_fn, Less&& less = Less()) {
+    return make_operator("stream::op::sort_by", [=](auto&& stream) mutable {
+        using T = StreamType<decltype(stream)>;
+        return Stream<T>(StreamProviderPtr<T>(
+            new provider::SortBy<T, std::decay_t<KeyFn>, std::decay_t<Less>, false>(
+                std::move(stream.getSource()), std::decay_t<KeyFn>(key_fn),
+                std::decay_t<Less>(less))));
+    });
+}
+
+CLASS_SPECIALIZATIONS(sort_by);
+
+// Keeps the first element for each key key_fn gives, in order of key,
+// calling it once per element.
+template<typename KeyFn, typename Less = std::less<void>>
+inline auto distinct_by(KeyFn&& key_fn, Less&& less = Less()) {
+    return make_operator("stream::op::distinct_by", [=](auto&& stream) mutable {
+        using T = StreamType<decltype(stream)>;
+        return Stream<T>(StreamProviderPtr<T>(
+            new provider::SortBy<T, std::decay_t<KeyFn>, std::decay_t<Less>, true>(
+                std::move(stream.getSource()), std::decay_t<KeyFn>(key_fn),
+                std::decay_t<Less>(less))));
+    });
+}
+
+CLASS_SPECIALIZATIONS(distinct_by);
+
 #undef CLASS_SPECIALIZATIONS
 
 } /* namespace op */
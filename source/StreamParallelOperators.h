@@ -0,0 +1,155 @@
+#ifndef SCHEINERMAN_STREAM_STREAM_PARALLEL_OPERATORS_H
+#define SCHEINERMAN_STREAM_STREAM_PARALLEL_OPERATORS_H
+
+namespace stream {
+namespace op {
+
+#define CLASS_SPECIALIZATIONS(operation) \
+    template<typename R, typename C> auto operation (R (C::*member)()) \
+        { return operation (std::mem_fn(member)); } \
+    template<typename R, typename C> auto operation (R (C::*member)() const) \
+        { return operation (std::mem_fn(member)); }
+
+// Like map_, but the function runs on the executor, with up to parallelism
+// chunks of elements in flight (by default one per executor thread). The
+// results come out in input order. The function is copied once per chunk
+// in flight and may run ahead of the consumer, so it should not depend on
+// shared state or on how far the stream has been read.
+template<typename Function>
+inline auto parallel_map(Function&& function, size_t parallelism = 0) {
+    return make_operator("stream::op::parallel_map", exec::detail::on_executor(
+        [=](auto&& stream, exec::Executor& executor) mutable {
+            using T = StreamType<decltype(stream)>;
+            using Result = std::result_of_t<Function(T&&)>;
+            static_assert(!std::is_void<Result>::value,
+                "Return type of the mapping function cannot be void.");
+
+            using F = std::decay_t<Function>;
+            return Stream<Result>(StreamProviderPtr<Result>(
+                new provider::ParallelMap<Result, F, T>(
+                    std::move(stream.getSource()), F(function),
+                    executor, parallelism)));
+        }));
+}
+
+CLASS_SPECIALIZATIONS(parallel_map);
+
+// Like parallel_map, but each chunk's results are emitted as soon as it is
+// done, so a slow element only holds back its own chunk. Meant for
+// terminators that do not care about order, such as count, sum or
+// to_unordered_set.
+template<typename Function>
+inline auto parallel_map_unordered(Function&& function, size_t parallelism = 0) {
+    return make_operator("stream::op::parallel_map_unordered", exec::detail::on_executor(
+        [=](auto&& stream, exec::Executor& executor) mutable {
+            using T = StreamType<decltype(stream)>;
+            using Result = std::result_of_t<Function(T&&)>;
+            static_assert(!std::is_void<Result>::value,
+                "Return type of the mapping function cannot be void.");
+
+            using F = std::decay_t<Function>;
+            return Stream<Result>(StreamProviderPtr<Result>(
+                new provider::ParallelMap<Result, F, T, false>(
+                    std::move(stream.getSource()), F(function),
+                    executor, parallelism)));
+        }));
+}
+
+CLASS_SPECIALIZATIONS(parallel_map_unordered);
+
+// Like filter, but the predicate runs on the executor and, as with
+// parallel_map_unordered, the surviving elements come out in whatever order
+// their chunks finish.
+template<typename Predicate>
+inline auto parallel_filter(Predicate&& predicate, size_t parallelism = 0) {
+    return make_operator("stream::op::parallel_filter", exec::detail::on_executor(
+        [=](auto&& stream, exec::Executor& executor) mutable {
+            using T = StreamType<decltype(stream)>;
+            using P = std::decay_t<Predicate>;
+            return Stream<T>(StreamProviderPtr<T>(
+                new provider::ParallelMap<T, P, T, false, provider::FilterStep>(
+                    std::move(stream.getSource()), P(predicate),
+                    executor, parallelism)));
+        }));
+}
+
+inline auto parallel_filter() {
+    return parallel_filter([](bool b) { return b; });
+}
+
+CLASS_SPECIALIZATIONS(parallel_filter);
+
+// Like flat_map, but the function, and the draining of the stream it
+// returns, run on the executor for several elements at once. With ordered
+// set the expansions come out in input order; otherwise each one comes out
+// as soon as its chunk is done.
+template<typename Transform>
+inline auto parallel_flat_map(Transform&& transform, size_t parallelism = 0,
+                              bool ordered = true) {
+    return make_operator("stream::op::parallel_flat_map", exec::detail::on_executor(
+        [=](auto&& stream, exec::Executor& executor) mutable {
+            using T = StreamType<decltype(stream)>;
+            using Result = std::result_of_t<Transform(T&&)>;
+            using S = StreamType<Result>;
+            static_assert(!std::is_void<S>::value,
+                "Flat map must be passed a function which returns a stream.");
+
+            using F = std::decay_t<Transform>;
+            using Ordered = provider::ParallelMap<S, F, T, true, provider::FlatMapStep>;
+            using Unordered = provider::ParallelMap<S, F, T, false, provider::FlatMapStep>;
+            auto& source = stream.getSource();
+            if(ordered) {
+                return Stream<S>(StreamProviderPtr<S>(new Ordered(
+                    std::move(source), F(transform), executor, parallelism)));
+            }
+            return Stream<S>(StreamProviderPtr<S>(new Unordered(
+                std::move(source), F(transform), executor, parallelism)));
+        }));
+}
+
+CLASS_SPECIALIZATIONS(parallel_flat_map);
+
+// Like sort, but collects the stream into one vector and sorts it on the
+// executor with a parallel merge sort. The sort is not stable.
+template<typename Less = std::less<void>>
+inline auto parallel_sort(Less&& less = Less()) {
+    return make_operator("stream::op::parallel_sort", exec::detail::on_executor(
+        [=](auto&& stream, exec::Executor& executor) mutable {
+            using T = StreamType<decltype(stream)>;
+            using L = std::decay_t<Less>;
+            return Stream<T>(make_stream_provider<provider::ParallelSort, T, L>(
+                std::move(stream.getSource()), L(less), executor));
+        }));
+}
+
+// Removes duplicate elements by hash on the executor, unlike distinct,
+// which sorts them. Elements come out grouped by hash shard, not in order.
+template<typename Hash = PolymorphicHash, typename Equal = std::equal_to<void>>
+inline auto parallel_distinct(const Hash& hash = Hash(), const Equal& equal = Equal()) {
+    return make_operator("stream::op::parallel_distinct", exec::detail::on_executor(
+        [=](auto&& stream, exec::Executor& executor) {
+            using T = StreamType<decltype(stream)>;
+            return Stream<T>(make_stream_provider<provider::ParallelDistinct, T, Hash, Equal>(
+                std::move(stream.getSource()), hash, equal, executor));
+        }));
+}
+
+// Runs everything upstream on a dedicated thread, which stays up to
+// capacity elements ahead of the stages downstream. Lets a slow or blocking
+// source overlap with the work done on its elements. Terminators such as
+// sum or to_vector pull op::detail::batch_size elements at a time, so they
+// only overlap fully with a capacity at least that large.
+inline auto async_buffer(size_t capacity) {
+    return make_operator("stream::op::async_buffer", [=](auto&& stream) {
+        using T = StreamType<decltype(stream)>;
+        return Stream<T>(make_stream_provider<provider::AsyncBuffer, T>(
+            std::move(stream.getSource()), capacity));
+    });
+}
+
+#undef CLASS_SPECIALIZATIONS
+
+} /* namespace op */
+} /* namespace stream */
+
+#endif
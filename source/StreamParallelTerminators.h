@@ -0,0 +1,510 @@
+#ifndef SCHEINERMAN_STREAM_STREAM_PARALLEL_TERMINATORS_H
+#define SCHEINERMAN_STREAM_STREAM_PARALLEL_TERMINATORS_H
+
+namespace stream {
+namespace op {
+
+#define CLASS_SPECIALIZATIONS(operation) \
+    template<typename R, typename C> auto operation (R (C::*member)()) \
+        { return operation (std::mem_fn(member)); } \
+    template<typename R, typename C> auto operation (R (C::*member)() const) \
+        { return operation (std::mem_fn(member)); }
+
+namespace detail {
+
+// Splits off up to 2^depth - 1 independent prefixes of provider, appending
+// them to pieces in stream order. Whatever stays in provider comes after
+// all of them.
+template<typename T, typename Provider>
+void split_into(Provider& provider, size_t depth,
+                std::vector<StreamProviderPtr<T>>& pieces) {
+    if(depth == 0) {
+        return;
+    }
+    StreamProviderPtr<T> prefix = provider->try_split();
+    if(!prefix) {
+        return;
+    }
+    split_into<T>(prefix, depth - 1, pieces);
+    pieces.push_back(std::move(prefix));
+    split_into<T>(provider, depth - 1, pieces);
+}
+
+// How many times to halve a source so that there are a few pieces for
+// each worker to balance the load.
+inline size_t split_depth(size_t workers) {
+    size_t depth = 1;
+    while((size_t(1) << depth) < workers * 4) {
+        depth++;
+    }
+    return depth;
+}
+
+constexpr size_t not_stopped = std::numeric_limits<size_t>::max();
+
+// Records that the part of the stream at index was stopped, unless an
+// earlier part already was.
+inline void stop_at(std::atomic<size_t>& stopped_at, size_t index) {
+    size_t current = stopped_at.load();
+    while(index < current && !stopped_at.compare_exchange_weak(current, index)) {}
+}
+
+// Folds every batch of provider into slot until it runs out, done holds or
+// fold requests a stop.
+template<typename T, typename U, typename Provider,
+         typename Fold, typename Combine, typename Done>
+void fold_all(Provider& provider, provider::Slot<U>& slot, Fold& fold,
+              Combine& combine, const Done& done, std::atomic<bool>& finished) {
+    std::vector<T> batch;
+    batch.reserve(batch_size);
+    while(!finished) {
+        batch.clear();
+        size_t pulled = provider->advance_batch(batch, batch_size);
+        if(pulled == 0) {
+            return;
+        }
+        if(!slot.occupied()) {
+            slot.emplace(fold(batch));
+        } else {
+            slot.emplace(combine(std::move(*slot), fold(batch)));
+        }
+        if(done(*slot)) {
+            finished = true;
+        }
+        if(stream::detail::take_stop_request() || pulled < batch_size) {
+            return;
+        }
+    }
+}
+
+// Reduces the rest of the source on the executor's threads, combining the partial
+// results in stream order, so combine only needs to be associative. Once
+// done returns true for a partial result no further batches are pulled.
+// Returns an empty slot when the stream was empty.
+//
+// Sources that can split are cut into independent pieces that workers fold
+// from start to finish without any locking. Otherwise workers take turns
+// pulling a batch from the shared source and fold it on their own, so fold
+// still runs in parallel while the source is only driven by one thread at a
+// time. A stop requested by fold, or by a stage of a split piece, drops
+// every piece or batch after the one it was requested in.
+template<typename T, typename U, typename Source,
+         typename Fold, typename Combine, typename Done>
+provider::Slot<U> parallel_fold(Source& source, exec::Executor& executor,
+                                const Fold& fold, Combine&& combine,
+                                const Done& done) {
+    using Partial = std::pair<size_t, U>;
+    using CombineFn = std::decay_t<Combine>;
+
+    size_t workers = executor.concurrency();
+    std::vector<StreamProviderPtr<T>> pieces;
+    if(workers > 1) {
+        split_into<T>(source, split_depth(workers), pieces);
+    }
+
+    std::vector<std::vector<Partial>> partials(workers);
+    std::mutex mutex;
+    size_t chunks = 0;
+    bool exhausted = false;
+    std::atomic<size_t> next_piece{0};
+    std::atomic<bool> finished{false};
+    std::atomic<size_t> stopped_at{not_stopped};
+    std::exception_ptr error;
+
+    auto shared = [&](std::vector<Partial>& results, Fold& local_fold) {
+        std::vector<T> batch;
+        batch.reserve(batch_size);
+        while(!finished) {
+            size_t chunk;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(exhausted) {
+                    return;
+                }
+                batch.clear();
+                size_t pulled = source->advance_batch(batch, batch_size);
+                exhausted = pulled < batch_size;
+                if(pulled == 0) {
+                    return;
+                }
+                chunk = chunks++;
+            }
+            results.emplace_back(chunk, local_fold(batch));
+            if(done(results.back().second)) {
+                finished = true;
+            }
+            if(stream::detail::take_stop_request()) {
+                stop_at(stopped_at, chunk);
+                finished = true;
+            }
+        }
+    };
+
+    // The pieces are claimed in order and the source itself, holding the
+    // tail of the stream, is the last one.
+    auto split = [&](std::vector<Partial>& results, Fold& local_fold) {
+        CombineFn local_combine = combine;
+        size_t index;
+        while(!finished && (index = next_piece++) <= pieces.size()
+                && index < stopped_at) {
+            provider::Slot<U> slot;
+            size_t stops = stream::detail::stops_taken();
+            if(index < pieces.size()) {
+                fold_all<T>(pieces[index], slot, local_fold, local_combine,
+                            done, finished);
+            } else {
+                fold_all<T>(source, slot, local_fold, local_combine,
+                            done, finished);
+            }
+            if(stream::detail::stops_taken() != stops) {
+                stop_at(stopped_at, index);
+            }
+            if(slot.occupied()) {
+                results.emplace_back(index, std::move(*slot));
+            }
+        }
+    };
+
+    auto work = [&](std::vector<Partial>& results) {
+        try {
+            Fold local_fold = fold;
+            if(pieces.empty()) {
+                shared(results, local_fold);
+            } else {
+                split(results, local_fold);
+            }
+        } catch(...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!error) {
+                error = std::current_exception();
+            }
+            finished = true;
+        }
+    };
+
+    exec::TaskGroup group(executor);
+    for(size_t i = 1; i < workers; i++) {
+        group.run([&work, &partials, i] { work(partials[i]); });
+    }
+    work(partials[0]);
+    group.wait();
+    if(error) {
+        std::rethrow_exception(error);
+    }
+
+    std::vector<provider::Slot<U>> ordered(pieces.empty() ? chunks : pieces.size() + 1);
+    for(auto& results : partials) {
+        for(auto& partial : results) {
+            if(partial.first <= stopped_at) {
+                ordered[partial.first].emplace(std::move(partial.second));
+            }
+        }
+    }
+    provider::Slot<U> result;
+    for(auto& partial : ordered) {
+        if(!partial.occupied()) {
+            continue;
+        }
+        if(!result.occupied()) {
+            result.emplace(std::move(*partial));
+        } else {
+            result.emplace(combine(std::move(*result), std::move(*partial)));
+        }
+    }
+    return result;
+}
+
+// Samples the rest of the source on the executor's threads. Each split
+// piece, or else each worker taking turns on the shared source, gets a
+// reservoir with a substream of its own, and the reservoirs are merged at
+// the end. Only the split pieces are sampled the same way on every run.
+template<typename T, typename Source>
+std::vector<T> parallel_sample(Source& source, exec::Executor& executor,
+                               size_t size, std::uint64_t seed) {
+    using Sample = provider::Reservoir<T, random::Philox>;
+    random::Philox engine(seed);
+
+    size_t workers = executor.concurrency();
+    std::vector<StreamProviderPtr<T>> pieces;
+    if(workers > 1) {
+        split_into<T>(source, split_depth(workers), pieces);
+    }
+
+    std::vector<provider::Slot<Sample>> samples(
+        pieces.empty() ? workers : pieces.size() + 1);
+    std::mutex mutex;
+    bool exhausted = false;
+    std::atomic<size_t> next_piece{0};
+    std::atomic<bool> failed{false};
+    std::atomic<size_t> stopped_at{not_stopped};
+    std::exception_ptr error;
+
+    auto shared = [&](size_t worker) {
+        Sample& sample = samples[worker].emplace(size, engine.substream(worker + 1));
+        std::vector<T> batch;
+        batch.reserve(batch_size);
+        while(!failed) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(exhausted) {
+                    return;
+                }
+                batch.clear();
+                exhausted = source->advance_batch(batch, batch_size) < batch_size;
+            }
+            for(auto&& element : batch) {
+                sample.add(std::move(element));
+            }
+        }
+    };
+
+    auto split = [&] {
+        size_t index;
+        while(!failed && (index = next_piece++) <= pieces.size()
+                && index < stopped_at) {
+            Sample& sample = samples[index].emplace(size, engine.substream(index + 1));
+            size_t stops = stream::detail::stops_taken();
+            if(index < pieces.size()) {
+                sample.add_all(pieces[index]);
+            } else {
+                sample.add_all(source);
+            }
+            if(stream::detail::stops_taken() != stops) {
+                stop_at(stopped_at, index);
+            }
+        }
+    };
+
+    auto work = [&](size_t worker) {
+        try {
+            if(pieces.empty()) {
+                shared(worker);
+            } else {
+                split();
+            }
+        } catch(...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!error) {
+                error = std::current_exception();
+            }
+            failed = true;
+        }
+    };
+
+    exec::TaskGroup group(executor);
+    for(size_t i = 1; i < workers; i++) {
+        group.run([&work, i] { work(i); });
+    }
+    work(0);
+    group.wait();
+    if(error) {
+        std::rethrow_exception(error);
+    }
+
+    Sample result(size, engine);
+    for(size_t i = 0; i < samples.size(); i++) {
+        if(samples[i].occupied() && i <= stopped_at) {
+            result.merge(std::move(*samples[i]));
+        }
+    }
+    return std::move(result.sample());
+}
+
+template<typename U, typename Identity, typename Accumulator>
+auto identity_fold(Identity identity, Accumulator accumulator) {
+    return [identity, accumulator](auto& batch) mutable {
+        U result = identity(std::move(batch.front()));
+        for(size_t i = 1; i < batch.size() && !stream::detail::stop_flag(); i++) {
+            result = accumulator(std::move(result), std::move(batch[i]));
+        }
+        return result;
+    };
+}
+
+inline auto never_done() {
+    return [](const auto&) { return false; };
+}
+
+} /* namespace detail */
+
+template<typename IdentityFn, typename Accumulator, typename Combiner>
+inline auto parallel_reduce(IdentityFn&& identityFn,
+                            Accumulator&& accumulator,
+                            Combiner&& combiner) {
+    return make_terminator("stream::op::parallel_reduce", exec::detail::on_executor(
+        [=](auto&& stream, exec::Executor& executor) mutable {
+            using T = StreamType<decltype(stream)>;
+            using U = std::result_of_t<IdentityFn(T&&)>;
+            auto result = detail::parallel_fold<T, U>(
+                stream.getSource(), executor,
+                detail::identity_fold<U>(identityFn, accumulator),
+                combiner,
+                detail::never_done());
+            if(!result.occupied()) {
+                throw EmptyStreamException("stream::op::parallel_reduce");
+            }
+            return std::move(*result);
+        }));
+}
+
+template<typename Accumulator, typename Combiner>
+inline auto parallel_reduce(Accumulator&& accumulator, Combiner&& combiner) {
+    return parallel_reduce([](auto&& x) { return std::forward<decltype(x)>(x); },
+                           std::forward<Accumulator>(accumulator),
+                           std::forward<Combiner>(combiner));
+}
+
+template<typename Accumulator>
+inline auto parallel_reduce(Accumulator&& accumulator) {
+    return parallel_reduce(accumulator, accumulator);
+}
+
+template<typename U, typename Accumulator, typename Combiner>
+inline auto parallel_identity_reduce(const U& identity,
+                                     Accumulator&& accumulator,
+                                     Combiner&& combiner) {
+    return make_terminator("stream::op::parallel_identity_reduce", exec::detail::on_executor(
+        [=](auto&& stream, exec::Executor& executor) mutable {
+            using T = StreamType<decltype(stream)>;
+            auto first = [identity, accumulator](T&& value) mutable {
+                return accumulator(U(identity), std::move(value));
+            };
+            auto result = detail::parallel_fold<T, U>(
+                stream.getSource(), executor,
+                detail::identity_fold<U>(first, accumulator),
+                combiner,
+                detail::never_done());
+            return result.occupied() ? std::move(*result) : identity;
+        }));
+}
+
+template<typename U, typename Accumulator>
+inline auto parallel_identity_reduce(const U& identity, Accumulator&& accumulator) {
+    return parallel_identity_reduce(identity, accumulator, accumulator);
+}
+
+inline auto parallel_count() {
+    return make_terminator("stream::op::parallel_count", exec::detail::on_executor(
+        [=](auto&& stream, exec::Executor& executor) {
+            using T = StreamType<decltype(stream)>;
+            auto& source = stream.getSource();
+            if(source->exact_size()) {
+                return source->size_hint();
+            }
+            auto result = detail::parallel_fold<T, size_t>(
+                source, executor,
+                [](auto& batch) { return batch.size(); },
+                std::plus<size_t>(),
+                detail::never_done());
+            return result.occupied() ? *result : 0;
+        }));
+}
+
+inline auto parallel_sum() {
+    return parallel_reduce(std::plus<void>())
+        .rename("stream::op::parallel_sum");
+}
+
+template<typename T>
+inline auto parallel_sum(const T& identity) {
+    return parallel_identity_reduce(identity, std::plus<T>())
+        .rename("stream::op::parallel_sum");
+}
+
+template<typename Less = std::less<void>>
+inline auto parallel_max(Less&& less = Less()) {
+    return parallel_reduce([=](auto&& a, auto&& b) {
+        return less(a, b) ? b : a;
+    }).rename("stream::op::parallel_max");
+}
+
+template<typename Less = std::less<void>>
+inline auto parallel_min(Less&& less = Less()) {
+    return parallel_reduce([=](auto&& a, auto&& b) {
+        return less(b, a) ? b : a;
+    }).rename("stream::op::parallel_min");
+}
+
+template<typename Predicate>
+inline auto parallel_any(Predicate&& predicate) {
+    return make_terminator("stream::op::parallel_any", exec::detail::on_executor(
+        [=](auto&& stream, exec::Executor& executor) {
+            using T = StreamType<decltype(stream)>;
+            auto result = detail::parallel_fold<T, bool>(
+                stream.getSource(), executor,
+                [predicate](auto& batch) mutable {
+                    for(auto&& element : batch) {
+                        if(predicate(element)) {
+                            return true;
+                        }
+                    }
+                    return false;
+                },
+                [](bool a, bool b) { return a || b; },
+                [](bool found) { return found; });
+            return result.occupied() && *result;
+        }));
+}
+
+inline auto parallel_any() {
+    return parallel_any([](bool b) { return b; });
+}
+
+CLASS_SPECIALIZATIONS(parallel_any);
+
+template<typename Predicate>
+inline auto parallel_all(Predicate&& predicate) {
+    return make_terminator("stream::op::parallel_all", exec::detail::on_executor(
+        [=](auto&& stream, exec::Executor& executor) {
+            using T = StreamType<decltype(stream)>;
+            auto result = detail::parallel_fold<T, bool>(
+                stream.getSource(), executor,
+                [predicate](auto& batch) mutable {
+                    for(auto&& element : batch) {
+                        if(!predicate(element)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                },
+                [](bool a, bool b) { return a && b; },
+                [](bool holds) { return !holds; });
+            return !result.occupied() || *result;
+        }));
+}
+
+inline auto parallel_all() {
+    return parallel_all([](bool b) { return b; });
+}
+
+CLASS_SPECIALIZATIONS(parallel_all);
+
+// Like random_sample, but sampling parts of the stream on separate threads
+// and merging their samples. Elements come out in no particular order.
+// The same seed gives the same sample only for sources that can split, such
+// as ranges or random-access containers. Otherwise the workers take turns
+// pulling batches from the source, and which worker samples which batch
+// depends on timing.
+inline auto parallel_random_sample(size_t size, std::uint64_t seed) {
+    return make_terminator("stream::op::parallel_random_sample", exec::detail::on_executor(
+        [=](auto&& stream, exec::Executor& executor) {
+            using T = StreamType<decltype(stream)>;
+            return detail::parallel_sample<T>(stream.getSource(), executor, size, seed);
+        }));
+}
+
+inline auto parallel_random_sample(size_t size) {
+    return make_terminator("stream::op::parallel_random_sample", exec::detail::on_executor(
+        [=](auto&& stream, exec::Executor& executor) {
+            using T = StreamType<decltype(stream)>;
+            auto seed = std::chrono::system_clock::now().time_since_epoch().count();
+            return detail::parallel_sample<T>(stream.getSource(), executor, size, seed);
+        }));
+}
+
+#undef CLASS_SPECIALIZATIONS
+
+} /* namespace op */
+} /* namespace stream */
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef SCHEINERMAN_STREAM_STREAM_RANDOM_H
+#define SCHEINERMAN_STREAM_STREAM_RANDOM_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace stream {
+namespace random {
+
+// The Philox4x32-10 counter-based engine of Salmon et al. Output number i of
+// substream s is a pure function of the seed, s and i, so an engine can
+// jump anywhere in its sequence in constant time, and substreams give
+// independent sequences that can be handed out to threads without any of
+// them depending on how many numbers the others have drawn.
+class Philox {
+
+public:
+    using result_type = std::uint32_t;
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    explicit Philox(std::uint64_t seed = 0, std::uint64_t substream = 0)
+        : key_{{static_cast<std::uint32_t>(seed),
+                static_cast<std::uint32_t>(seed >> 32)}},
+          substream_(substream) {}
+
+    void seed(std::uint64_t seed = 0) {
+        *this = Philox(seed, substream_);
+    }
+
+    result_type operator() () {
+        std::uint64_t block = position_ / 4;
+        if(!cached_ || block != block_) {
+            output_ = generate(block);
+            block_ = block;
+            cached_ = true;
+        }
+        return output_[position_++ % 4];
+    }
+
+    void discard(unsigned long long n) {
+        position_ += n;
+    }
+
+    // An engine for another substream with the same seed, starting at its
+    // beginning.
+    Philox substream(std::uint64_t index) const {
+        Philox engine;
+        engine.key_ = key_;
+        engine.substream_ = index;
+        return engine;
+    }
+
+    // The block of four outputs for a 128-bit counter and 64-bit key.
+    static std::array<std::uint32_t, 4> block(std::array<std::uint32_t, 4> counter,
+                                              std::array<std::uint32_t, 2> key) {
+        for(int round = 0; round < 10; round++) {
+            if(round > 0) {
+                key[0] += 0x9E3779B9;
+                key[1] += 0xBB67AE85;
+            }
+            std::uint64_t first = std::uint64_t(0xD2511F53) * counter[0];
+            std::uint64_t second = std::uint64_t(0xCD9E8D57) * counter[2];
+            counter = {{static_cast<std::uint32_t>(second >> 32) ^ counter[1] ^ key[0],
+                        static_cast<std::uint32_t>(second),
+                        static_cast<std::uint32_t>(first >> 32) ^ counter[3] ^ key[1],
+                        static_cast<std::uint32_t>(first)}};
+        }
+        return counter;
+    }
+
+    friend bool operator== (const Philox& left, const Philox& right) {
+        return left.key_ == right.key_ && left.substream_ == right.substream_
+            && left.position_ == right.position_;
+    }
+
+    friend bool operator!= (const Philox& left, const Philox& right) {
+        return !(left == right);
+    }
+
+private:
+    std::array<std::uint32_t, 2> key_;
+    std::uint64_t substream_;
+    std::uint64_t position_ = 0;
+    std::array<std::uint32_t, 4> output_{};
+    std::uint64_t block_ = 0;
+    bool cached_ = false;
+
+    std::array<std::uint32_t, 4> generate(std::uint64_t index) const {
+        return block({{static_cast<std::uint32_t>(index),
+                       static_cast<std::uint32_t>(index >> 32),
+                       static_cast<std::uint32_t>(substream_),
+                       static_cast<std::uint32_t>(substream_ >> 32)}}, key_);
+    }
+
+};
+
+// Engines with a substream method. Random streams built on one of these
+// draw each element from a substream of its own, which lets them seek and
+// split.
+template<typename Engine>
+struct is_counter_based : std::false_type {};
+
+template<>
+struct is_counter_based<Philox> : std::true_type {};
+
+} /* namespace random */
+} /* namespace stream */
+
+#endif
@@ -10,27 +10,58 @@ namespace op {
     template<typename R, typename C> auto operation (R (C::*member)() const) \
         { return operation (std::mem_fn(member)); }
 
+namespace detail {
+
+using provider::batch_size;
+
+// Pulls the rest of the stream through advance_batch and hands each element
+// to function as an rvalue, so sources that can fill a batch natively do not
+// pay for a virtual call per element. A stop requested by function ends the
+// drain after that element.
+template<typename T, typename Source, typename Function>
+void drain(Source& source, Function&& function) {
+    std::vector<T> batch;
+    batch.reserve(batch_size);
+    size_t pulled;
+    do {
+        batch.clear();
+        pulled = source->advance_batch(batch, batch_size);
+        for(auto&& element : batch) {
+            function(std::move(element));
+            if(stream::detail::take_stop_request()) {
+                return;
+            }
+        }
+    } while(pulled == batch_size);
+}
+
+} /* namespace detail */
+
 template<typename Function>
 inline auto for_each(Function&& function) {
     return make_terminator("stream::op::for_each", [=](auto&& stream) mutable {
-        auto& source = stream.getSource();
-        while(source->advance()) {
-            function(std::move(*source->get()));
-        }
+        using T = StreamType<decltype(stream)>;
+        detail::drain<T>(stream.getSource(), [&](T&& element) {
+            function(std::move(element));
+        });
         return function;
     });
 }
 
 CLASS_SPECIALIZATIONS(for_each);
 
+// Answers without pulling anything when the pipeline knows its exact length.
+// Stages that call user functions, such as map_ or peek, never claim to know
+// it, so those functions still see every element.
 inline auto count() {
     return make_terminator("stream::op::count", [=](auto&& stream) {
+        using T = StreamType<decltype(stream)>;
         auto& source = stream.getSource();
-        size_t count = 0;
-        while(source->advance()) {
-            std::move(*source->get());
-            count++;
+        if(source->exact_size()) {
+            return source->size_hint();
         }
+        size_t count = 0;
+        detail::drain<T>(stream.getSource(), [&](T&&) { count++; });
         return count;
     });
 }
@@ -38,11 +69,11 @@ inline auto count() {
 template<typename U, typename Accumulator>
 inline auto identity_reduce(const U& identity, Accumulator&& accumulator) {
     return make_terminator("stream::op::identity_reduce", [=](auto&& stream) mutable {
-        auto& source = stream.getSource();
+        using T = StreamType<decltype(stream)>;
         U result = identity;
-        while(source->advance()) {
-            result = accumulator(std::move(result), std::move(*source->get()));
-        }
+        detail::drain<T>(stream.getSource(), [&](T&& element) {
+            result = accumulator(std::move(result), std::move(element));
+        });
         return result;
     });
 }
@@ -52,7 +83,7 @@ inline auto reduce(Accumulator&& accumulator) {
     return make_terminator("stream::op::reduce", [=](auto&& stream) mutable {
         auto& source = stream.getSource();
         if(source->advance()) {
-            auto reduction = identity_reduce(std::move(*source->get()),
+            auto reduction = identity_reduce(std::move(source->value()),
                                              std::forward<Accumulator>(accumulator));
             return stream | reduction;
         } else {
@@ -66,7 +97,7 @@ inline auto reduce(IdentityFn&& identityFn, Accumulator&& accumulator) {
     return make_terminator("stream::op::reduce", [=](auto&& stream) mutable {
         auto& source = stream.getSource();
         if(source->advance()) {
-            auto reduction = identity_reduce(identityFn(std::move(*source->get())),
+            auto reduction = identity_reduce(identityFn(std::move(source->value())),
                                              std::forward<Accumulator>(accumulator));
             return stream | reduction;
         } else {
@@ -78,8 +109,9 @@ inline auto reduce(IdentityFn&& identityFn, Accumulator&& accumulator) {
 inline auto first() {
     return make_terminator("stream::op::first", [=](auto&& stream) {
         auto& source = stream.getSource();
+        detail::keep_first(source, 1);
         if(source->advance()) {
-            return std::move(*source->get());
+            return std::move(source->value());
         } else {
             throw EmptyStreamException("stream::op::first");
         }
@@ -92,7 +124,7 @@ inline auto last() {
 }
 
 inline auto nth(size_t index) {
-    return (skip(index) | first()).rename("stream::op::nth");
+    return (slice(index, index + 1) | first()).rename("stream::op::nth");
 }
 
 inline auto sum() {
@@ -212,7 +244,7 @@ inline auto any(Predicate&& predicate) {
     return make_terminator("stream::op::any", [=](auto&& stream) mutable {
         auto& source = stream.getSource();
         while(source->advance()) {
-            if(predicate(*source->get())) {
+            if(predicate(source->value())) {
                 return true;
             }
         }
@@ -231,7 +263,7 @@ inline auto all(Predicate&& predicate) {
     return make_terminator("stream::op::all", [=](auto&& stream) mutable {
         auto& source = stream.getSource();
         while(source->advance()) {
-            if(!predicate(*source->get())) {
+            if(!predicate(source->value())) {
                 return false;
             }
         }
@@ -275,11 +307,10 @@ template<typename OutputIterator>
 inline auto copy_to(OutputIterator out) {
     return make_terminator("stream::op::copy_to", [=](auto&& stream) mutable {
         using T = StreamType<decltype(stream)>;
-        auto& source = stream.getSource();
-        while(source->advance()) {
-            *out = *source->get();
+        detail::drain<T>(stream.getSource(), [&](T&& element) {
+            *out = std::move(element);
             ++out;
-        }
+        });
         return out;
     });
 }
@@ -288,11 +319,10 @@ template<typename OutputIterator>
 inline auto move_to(OutputIterator out) {
     return make_terminator("stream::op::move_to", [=](auto&& stream) mutable {
         using T = StreamType<decltype(stream)>;
-        auto& source = stream.getSource();
-        while(source->advance()) {
-            *out = std::move(*source->get());
+        detail::drain<T>(stream.getSource(), [&](T&& element) {
+            *out = std::move(element);
             ++out;
-        }
+        });
         return out;
     });
 }
@@ -305,38 +335,22 @@ inline auto print_to(std::ostream& os, const char* delimiter = " ") {
     });
 }
 
-inline auto random_sample(size_t size) {
+// Picks size elements uniformly at random, or all of them, in stream order,
+// when there are no more than that. Elements that are not kept are passed
+// over with advance_by, without drawing a random number for each.
+inline auto random_sample(size_t size, std::uint64_t seed) {
     return make_terminator("stream::op::random_sample", [=](auto&& stream) {
         using T = StreamType<decltype(stream)>;
-        auto& source = stream.getSource();
-
-        std::vector<T> results;
-        for(int i = 0; i < size; i++) {
-            if(source->advance()) {
-                results.push_back(std::move(*source->get()));
-            } else {
-                return results;
-            }
-        }
+        provider::Reservoir<T, random::Philox> reservoir(size, random::Philox(seed));
+        reservoir.add_all(stream.getSource());
+        return std::move(reservoir.sample());
+    });
+}
 
+inline auto random_sample(size_t size) {
+    return make_terminator("stream::op::random_sample", [=](auto&& stream) {
         auto seed = std::chrono::system_clock::now().time_since_epoch().count();
-        std::default_random_engine generator(seed);
-        auto random_index = [&generator](int upper) {
-            return std::uniform_int_distribution<int>(0, upper - 1)(generator);
-        };
-
-        size_t seen = size;
-        while(source->advance()) {
-            seen++;
-            int index = random_index(seen);
-            if(index < size) {
-                results[index] = std::move(*source->get());
-            } else {
-                source->get();
-            }
-        }
-
-        return results;
+        return stream | random_sample(size, seed);
     });
 }
 
@@ -4,6 +4,7 @@
 #include "StreamForward.h"
 #include "UtilityImpl.h"
 
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <tuple>
@@ -79,6 +80,13 @@ private:
     Compare comparator_;
 };
 
+struct PolymorphicHash {
+    template<typename T>
+    decltype(auto) operator() (const T& value) const {
+        return std::hash<T>{}(value);
+    }
+};
+
 template<typename... Args>
 std::ostream& operator<< (std::ostream& os, const std::tuple<Args...>& tuple) {
 
@@ -18,32 +18,32 @@ public:
     AdjacentDifference(StreamProviderPtr<T> source, Subtractor&& subtract)
         : source_(std::move(source)), subtract_(subtract) {}
 
-    std::shared_ptr<DiffType> get() override {
-        return result_;
+    DiffType& value() override {
+        return *result_;
     }
 
     bool advance_impl() override {
         if(first_advance_) {
             first_advance_ = false;
             if(source_->advance()) {
-                first_ = source_->get();
+                first_.emplace(std::move(source_->value()));
             } else {
                 return false;
             }
             if(source_->advance()) {
-                second_ = source_->get();
+                second_.emplace(std::move(source_->value()));
             } else {
                 first_.reset();
                 return false;
             }
-            result_ = std::make_shared<DiffType>(subtract_(*second_, *first_));
+            result_.emplace(subtract_(*second_, *first_));
             return true;
         }
 
         first_ = std::move(second_);
         if(source_->advance()) {
-            second_ = source_->get();
-            result_ = std::make_shared<DiffType>(subtract_(*second_, *first_));
+            second_.emplace(std::move(source_->value()));
+            result_.emplace(subtract_(*second_, *first_));
             return true;
         }
         first_.reset();
@@ -60,9 +60,9 @@ public:
 private:
     StreamProviderPtr<T> source_;
     Subtractor subtract_;
-    std::shared_ptr<T> first_;
-    std::shared_ptr<T> second_;
-    std::shared_ptr<DiffType> result_;
+    Slot<T> first_;
+    Slot<T> second_;
+    Slot<DiffType> result_;
     bool first_advance_ = true;
 };
 
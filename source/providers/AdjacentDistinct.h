@@ -12,26 +12,28 @@ class AdjacentDistinct : public StreamProvider<T> {
 
 public:
     AdjacentDistinct(StreamProviderPtr<T> source, Equal&& equal)
-        : source_(std::move(source)), equal_(std::forward<Equal>(equal_)) {}
+        : source_(std::move(source)), equal_(std::forward<Equal>(equal)) {}
 
-    std::shared_ptr<T> get() override {
-        return current_;
+    T& value() override {
+        return *current_;
     }
 
     bool advance_impl() override {
         if(first_) {
             first_ = false;
             if(source_->advance()) {
-                current_ = source_->get();
+                last_.emplace(source_->value());
+                current_.emplace(std::move(source_->value()));
                 return true;
             }
             return false;
         }
 
         while(source_->advance()) {
-            auto next = source_->get();
-            if(!equal_(*current_, *next)) {
-                current_ = next;
+            T& next = source_->value();
+            if(!equal_(*last_, next)) {
+                last_.emplace(next);
+                current_.emplace(std::move(next));
                 return true;
             }
         }
@@ -49,7 +51,8 @@ public:
 private:
     StreamProviderPtr<T> source_;
     Equal equal_;
-    std::shared_ptr<T> current_;
+    Slot<T> last_;
+    Slot<T> current_;
     bool first_ = true;
 };
 
@@ -0,0 +1,139 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_ASYNC_BUFFER_H
+#define SCHEINERMAN_STREAM_PROVIDERS_ASYNC_BUFFER_H
+
+#include "StreamProvider.h"
+#include "RingBuffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace stream {
+namespace provider {
+
+// Drains the source on a thread of its own, handing elements over through
+// a ring buffer of the given capacity, so the stages upstream run while
+// the ones downstream work. The thread starts on the first advance and
+// stops early if the provider is destroyed first.
+template<typename T>
+class AsyncBuffer : public StreamProvider<T> {
+
+public:
+    AsyncBuffer(StreamProviderPtr<T> source, size_t capacity)
+        : source_(std::move(source)), buffer_(capacity) {}
+
+    ~AsyncBuffer() {
+        cancelled_ = true;
+        if(producer_.joinable()) {
+            producer_.join();
+        }
+    }
+
+    T& value() override {
+        return *current_;
+    }
+
+    bool advance_impl() override {
+        start();
+        Backoff backoff;
+        while(!buffer_.try_pop(current_)) {
+            if(finished_.load(std::memory_order_acquire)) {
+                // The producer may have pushed its last elements just
+                // before finishing.
+                if(buffer_.try_pop(current_)) {
+                    return true;
+                }
+                current_.reset();
+                rethrow();
+                return false;
+            }
+            backoff.wait();
+        }
+        return true;
+    }
+
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        size_t count = 0;
+        batch.reserve(batch.size() + std::min(n, buffer_.capacity()));
+        while(count < n && advance_impl()) {
+            batch.push_back(std::move(*current_));
+            count++;
+        }
+        current_.reset();
+        return count;
+    }
+
+    size_t size_hint() const override {
+        return producer_.joinable() ? 0 : source_->size_hint();
+    }
+
+    bool exact_size() const override {
+        return !producer_.joinable() && source_->exact_size();
+    }
+
+    PrintInfo print(std::ostream& os, int indent) const override {
+        this->print_indent(os, indent);
+        os << "AsyncBuffer:\n";
+        return source_->print(os, indent + 1).addStage();
+    }
+
+private:
+    StreamProviderPtr<T> source_;
+    RingBuffer<T> buffer_;
+    Slot<T> current_;
+    std::atomic<bool> finished_{false};
+    std::atomic<bool> cancelled_{false};
+    std::exception_ptr error_;
+    std::thread producer_;
+
+    void start() {
+        if(!producer_.joinable() && !finished_) {
+            producer_ = std::thread([this] { produce(); });
+        }
+    }
+
+    void produce() {
+        // Small enough pulls that elements start flowing before the ring
+        // fills up.
+        size_t chunk = std::max<size_t>(1, std::min<size_t>(buffer_.capacity() / 4, 64));
+        std::vector<T> batch;
+        batch.reserve(chunk);
+        try {
+            while(!cancelled_) {
+                batch.clear();
+                size_t pulled = source_->advance_batch(batch, chunk);
+                for(auto&& element : batch) {
+                    Backoff backoff;
+                    while(!buffer_.try_push(std::move(element))) {
+                        if(cancelled_) {
+                            return;
+                        }
+                        backoff.wait();
+                    }
+                }
+                if(pulled < chunk) {
+                    break;
+                }
+            }
+        } catch(...) {
+            error_ = std::current_exception();
+        }
+        finished_.store(true, std::memory_order_release);
+    }
+
+    void rethrow() {
+        if(error_) {
+            std::exception_ptr error = error_;
+            error_ = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
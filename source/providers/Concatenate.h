@@ -3,6 +3,7 @@
 
 #include "StreamProvider.h"
 
+#include <iterator>
 #include <list>
 
 namespace stream {
@@ -20,23 +21,76 @@ public:
         sources_.push_back(std::move(second));
     }
 
+    T& value() override {
+        return sources_.front()->value();
+    }
+
     std::shared_ptr<T> get() override {
-        return current_;
+        return sources_.front()->get();
     }
 
+    // A stop inside one of the sources ends the whole concatenation.
     bool advance_impl() override {
         while(!sources_.empty()) {
-            auto& provider = sources_.front();
-            if(provider->advance()) {
-                current_ = provider->get();
-                return true;
+            size_t stops = stream::detail::stops_taken();
+            bool advanced = sources_.front()->advance();
+            if(advanced || stream::detail::relay_stop(stops)) {
+                return advanced;
             }
             sources_.pop_front();
         }
-        current_.reset();
         return false;
     }
 
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        size_t count = 0;
+        while(count < n && !sources_.empty()) {
+            size_t wanted = n - count;
+            size_t stops = stream::detail::stops_taken();
+            size_t pulled = sources_.front()->advance_batch(batch, wanted);
+            count += pulled;
+            if(stream::detail::relay_stop(stops)) {
+                break;
+            }
+            if(pulled < wanted) {
+                sources_.pop_front();
+            }
+        }
+        return count;
+    }
+
+    StreamProviderPtr<T> try_split() override {
+        if(sources_.size() == 1) {
+            return sources_.front()->try_split();
+        }
+        if(sources_.empty()) {
+            return nullptr;
+        }
+        auto middle = std::next(sources_.begin(), sources_.size() / 2);
+        StreamProviderPtr<T> prefix(new Concatenate<T>(
+            std::make_move_iterator(sources_.begin()),
+            std::make_move_iterator(middle)));
+        sources_.erase(sources_.begin(), middle);
+        return prefix;
+    }
+
+    size_t size_hint() const override {
+        size_t total = 0;
+        for(auto& source : sources_) {
+            total += source->size_hint();
+        }
+        return total;
+    }
+
+    bool exact_size() const override {
+        for(auto& source : sources_) {
+            if(!source->exact_size()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     void concat(StreamProviderPtr<T>&& source) {
         sources_.push_back(std::move(source));
     }
@@ -53,7 +107,6 @@ public:
 
 private:
     std::list<StreamProviderPtr<T>> sources_;
-    std::shared_ptr<T> current_;
 
 };
 
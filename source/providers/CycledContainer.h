@@ -3,6 +3,9 @@
 
 #include "StreamProvider.h"
 
+#include <iterator>
+#include <memory>
+
 namespace stream {
 namespace provider {
 
@@ -11,28 +14,111 @@ class CycledContainer : public StreamProvider<T> {
 
 public:
     CycledContainer(Container&& container, size_t times)
-        : container_{container},
-          current_{std::begin(container_)},
-          end_{std::end(container_)},
-          times_{times} {}
+        : CycledContainer(std::make_shared<const Container>(std::move(container)), times) {}
 
-    std::shared_ptr<T> get() override {
-        return std::make_shared<T>(std::move(*current_));
+    T& value() override {
+        if(!value_.occupied()) {
+            value_.emplace(std::move(*current_));
+        }
+        return *value_;
     }
 
     bool advance_impl() override {
+        value_.reset();
         if(first_) {
             first_ = false;
             return current_ != end_;
         }
-        ++current_;
-        if(current_ == end_) {
-            iteration_++;
-            if(iteration_ > times_ && times_ != 0)
-                return false;
-            current_ = std::begin(container_);
+        return step();
+    }
+
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        value_.reset();
+        if(n == 0) {
+            return 0;
         }
-        return true;
+        if(first_) {
+            first_ = false;
+            if(current_ == end_) {
+                return 0;
+            }
+        } else if(!step()) {
+            return 0;
+        }
+        size_t count = 0;
+        do {
+            batch.push_back(std::move(*current_));
+        } while(++count < n && step());
+        return count;
+    }
+
+    size_t advance_by_impl(size_t n) override {
+        value_.reset();
+        if(n == 0) {
+            return 0;
+        }
+        size_t count = 0;
+        if(first_) {
+            first_ = false;
+            if(current_ == end_) {
+                return 0;
+            }
+            count = 1;
+        } else if(current_ == end_) {
+            return 0;
+        }
+        // Land on the element n - count steps on from the current one,
+        // wrapping around as many whole passes as that takes.
+        size_t size = std::distance(begin_, end_);
+        size_t offset = std::distance(begin_, current_);
+        size_t target = offset + (n - count);
+        size_t passes = target / size;
+        if(times_ != 0 && iteration_ + passes > times_) {
+            size_t left = (size - offset - 1) + size * (times_ - iteration_);
+            current_ = end_;
+            iteration_ = times_ + 1;
+            return count + left;
+        }
+        iteration_ += passes;
+        current_ = begin_;
+        std::advance(current_, target % size);
+        return n;
+    }
+
+    // Repeated streams split between passes, single passes down the middle.
+    // The pieces share the container, which is only ever copied from.
+    StreamProviderPtr<T> try_split() override {
+        if(!first_ || times_ == 0) {
+            return nullptr;
+        }
+        if(times_ > 1) {
+            size_t half = times_ / 2;
+            times_ -= half;
+            return StreamProviderPtr<T>(
+                new CycledContainer(container_, begin_, end_, half));
+        }
+        size_t size = std::distance(begin_, end_);
+        if(size < 2) {
+            return nullptr;
+        }
+        Iterator middle = begin_;
+        std::advance(middle, size / 2);
+        StreamProviderPtr<T> prefix(new CycledContainer(container_, begin_, middle, 1));
+        begin_ = current_ = middle;
+        return prefix;
+    }
+
+    size_t size_hint() const override {
+        if(times_ == 0 || (!first_ && current_ == end_)) {
+            return 0;
+        }
+        size_t size = std::distance(begin_, end_);
+        size_t rest = std::distance(current_, end_) - (first_ ? 0 : 1);
+        return rest + size * (times_ - iteration_);
+    }
+
+    bool exact_size() const override {
+        return times_ != 0;
     }
 
     PrintInfo print(std::ostream& os, int indent) const override {
@@ -42,14 +128,41 @@ public:
     }
 
 private:
-    using Iterator = decltype(std::begin(std::declval<Container>()));
+    using Iterator = decltype(std::begin(std::declval<const Container&>()));
+
+    CycledContainer(std::shared_ptr<const Container> container, size_t times)
+        : CycledContainer(container, std::begin(*container), std::end(*container), times) {}
+
+    CycledContainer(std::shared_ptr<const Container> container,
+                    Iterator begin, Iterator end, size_t times)
+        : container_{std::move(container)},
+          begin_{begin},
+          current_{begin},
+          end_{end},
+          times_{times} {}
+
+    bool step() {
+        if(current_ == end_) {
+            return false;
+        }
+        ++current_;
+        if(current_ == end_) {
+            iteration_++;
+            if(iteration_ > times_ && times_ != 0)
+                return false;
+            current_ = begin_;
+        }
+        return true;
+    }
 
     bool first_ = true;
-    Container container_;
+    std::shared_ptr<const Container> container_;
+    Iterator begin_;
     Iterator current_;
     Iterator end_;
     size_t times_;
     size_t iteration_ = 1;
+    Slot<T> value_;
 };
 
 } /* namespace provider */
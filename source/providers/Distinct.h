@@ -16,6 +16,10 @@ public:
     Distinct(StreamProviderPtr<T> source, RawCompare&& comparator)
         : source_(std::move(source)), sorted_(PointerCompare(std::forward<RawCompare>(comparator))) {}
 
+    T& value() override {
+        return *current_;
+    }
+
     std::shared_ptr<T> get() override {
         return current_;
     }
@@ -0,0 +1,56 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_DISTINCT_UNORDERED_H
+#define SCHEINERMAN_STREAM_PROVIDERS_DISTINCT_UNORDERED_H
+
+#include "StreamProvider.h"
+#include "Filter.h"
+#include "OpenHashSet.h"
+
+namespace stream {
+namespace provider {
+
+// Passes each element on the first time it is seen, in stream order,
+// remembering a copy of it in a hash set. Unlike Distinct it never needs
+// the rest of the source, so it also works on infinite streams.
+template<typename T, typename Hash, typename Equal>
+class DistinctUnordered : public StreamProvider<T> {
+
+public:
+    DistinctUnordered(StreamProviderPtr<T> source, const Hash& hash, const Equal& equal)
+        : source_(std::move(source)), seen_(hash, equal) {}
+
+    T& value() override {
+        return source_->value();
+    }
+
+    std::shared_ptr<T> get() override {
+        return source_->get();
+    }
+
+    bool advance_impl() override {
+        return detail::filter_next(source_, first_seen());
+    }
+
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        return detail::filter_batch(source_, batch, n, first_seen());
+    }
+
+    PrintInfo print(std::ostream& os, int indent) const override {
+        this->print_indent(os, indent);
+        os << "DistinctUnordered:\n";
+        return source_->print(os, indent + 1).addStage();
+    }
+
+private:
+    auto first_seen() {
+        return [this](const T& value) { return seen_.insert(value); };
+    }
+
+    StreamProviderPtr<T> source_;
+    OpenHashSet<T, Hash, Equal> seen_;
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
@@ -6,35 +6,35 @@
 namespace stream {
 namespace provider {
 
-template<typename T, typename Predicate>
+template<typename T, typename Predicate, typename Source = StreamProviderPtr<T>>
 class DropWhile : public StreamProvider<T> {
 
 public:
-    DropWhile(StreamProviderPtr<T> source, Predicate&& predicate)
+    DropWhile(Source source, Predicate&& predicate)
         : source_(std::move(source)), predicate_(predicate) {}
 
+    T& value() override {
+        return source_->value();
+    }
+
     std::shared_ptr<T> get() override {
-        return current_;
+        return source_->get();
     }
 
     bool advance_impl() override {
         if(!dropped_) {
             dropped_ = true;
             while(source_->advance()) {
-                current_ = source_->get();
-                if(!predicate_(*current_)) {
+                if(!predicate_(source_->value())) {
                     return true;
                 }
+                if(stream::detail::stop_flag()) {
+                    return false;
+                }
             }
-            current_.reset();
             return false;
         }
-        if(source_->advance()) {
-            current_ = source_->get();
-            return true;
-        }
-        current_.reset();
-        return false;
+        return source_->advance();
     }
 
     PrintInfo print(std::ostream& os, int indent) const override {
@@ -44,9 +44,8 @@ public:
     }
 
 private:
-    StreamProviderPtr<T> source_;
+    Source source_;
     Predicate predicate_;
-    std::shared_ptr<T> current_;
     bool dropped_ = false;
 };
 
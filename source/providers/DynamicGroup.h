@@ -15,16 +15,16 @@ class DynamicGroup : public StreamProvider<std::vector<T>> {
 public:
     DynamicGroup(StreamProviderPtr<T> source, size_t N) : source_(std::move(source)), N_(N) {}
 
-    std::shared_ptr<std::vector<T>> get() override {
-        return current_;
+    std::vector<T>& value() override {
+        return *current_;
     }
 
     bool advance_impl() override {
-        current_ = std::make_shared<std::vector<T>>();
+        current_.emplace();
         current_->reserve(N_);
         for(int i = 0; i < N_; i++) {
             if(source_->advance()) {
-                current_->emplace_back(std::move(*source_->get()));
+                current_->emplace_back(std::move(source_->value()));
             } else {
                 current_.reset();
                 return false;
@@ -33,6 +33,14 @@ public:
         return true;
     }
 
+    size_t size_hint() const override {
+        return source_->size_hint() / N_;
+    }
+
+    bool exact_size() const override {
+        return source_->exact_size();
+    }
+
     PrintInfo print(std::ostream& os, int indent) const override {
         this->print_indent(os, indent);
         os << "Grouped[" << N_ << "]:\n";
@@ -41,7 +49,7 @@ public:
 
 private:
     StreamProviderPtr<T> source_;
-    std::shared_ptr<std::vector<T>> current_;
+    Slot<std::vector<T>> current_;
     const size_t N_;
 
 };
@@ -17,29 +17,28 @@ private:
 public:
     DynamicOverlap(StreamProviderPtr<T> source, size_t N) : source_(std::move(source)), N_(N) {}
 
-    std::shared_ptr<Result> get() override {
-        return current_;
+    Result& value() override {
+        return *current_;
     }
 
     bool advance_impl() override {
         if(first_) {
             first_ = false;
-            current_ = std::make_shared<Result>();
             for(size_t i = 0; i < N_; i++) {
                 if(source_->advance()) {
-                    current_->emplace_back(std::move(*source_->get()));
+                    window_.emplace_back(std::move(source_->value()));
                 } else {
-                    current_.reset();
                     return false;
                 }
             }
+            current_.emplace(window_);
             return true;
         }
 
         if(source_->advance()) {
-            current_ = std::make_shared<Result>(*current_);
-            current_->pop_front();
-            current_->emplace_back(std::move(*source_->get()));
+            window_.pop_front();
+            window_.emplace_back(std::move(source_->value()));
+            current_.emplace(window_);
             return true;
         }
         current_.reset();
@@ -55,7 +54,8 @@ public:
 private:
     bool first_ = true;
     StreamProviderPtr<T> source_;
-    std::shared_ptr<Result> current_;
+    Result window_;
+    Slot<Result> current_;
     const size_t N_;
 
 };
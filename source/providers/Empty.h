@@ -10,6 +10,10 @@ template<typename T>
 class Empty : public StreamProvider<T> {
 
 public:
+    T& value() override {
+        throw EmptyStreamException("stream::provider::Empty::value");
+    }
+
     std::shared_ptr<T> get() override {
         return nullptr;
     }
@@ -18,6 +22,10 @@ public:
         return false;
     }
 
+    bool exact_size() const override {
+        return true;
+    }
+
     PrintInfo print(std::ostream& os, int indent) const override {
         this->print_indent(os, indent);
         os << "[empty stream]\n";
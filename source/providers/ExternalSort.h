@@ -0,0 +1,376 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_EXTERNAL_SORT_H
+#define SCHEINERMAN_STREAM_PROVIDERS_EXTERNAL_SORT_H
+
+#include "StreamProvider.h"
+#include "Sort.h"
+
+#include "../StreamError.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace stream {
+namespace provider {
+
+// How an external sort writes elements to its temporary files and reads
+// them back, and how much memory it counts each element as using. Types
+// that can be copied bit for bit are written as they are in memory.
+template<typename T>
+struct SpillCodec {
+    static_assert(std::is_trivially_copyable<T>::value,
+        "External sort needs a trivially copyable type or a SpillCodec for it.");
+
+    static size_t footprint(const T&) {
+        return sizeof(T);
+    }
+
+    static bool write(std::FILE* file, const T* values, size_t count) {
+        return std::fwrite(values, sizeof(T), count, file) == count;
+    }
+
+    // Appends up to count elements to values, returning how many it read.
+    static size_t read(std::FILE* file, std::vector<T>& values, size_t count) {
+        size_t start = values.size();
+        values.resize(start + count);
+        size_t read = std::fread(values.data() + start, sizeof(T), count, file);
+        values.resize(start + read);
+        return read;
+    }
+};
+
+// Strings are written as their length followed by their characters.
+template<>
+struct SpillCodec<std::string> {
+    static size_t footprint(const std::string& value) {
+        return sizeof(std::string) + value.capacity();
+    }
+
+    static bool write(std::FILE* file, const std::string* values, size_t count) {
+        for(size_t i = 0; i < count; i++) {
+            std::uint64_t length = values[i].size();
+            if(std::fwrite(&length, sizeof(length), 1, file) != 1
+                    || std::fwrite(values[i].data(), 1, length, file) != length) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static size_t read(std::FILE* file, std::vector<std::string>& values, size_t count) {
+        for(size_t i = 0; i < count; i++) {
+            std::uint64_t length;
+            if(std::fread(&length, sizeof(length), 1, file) != 1) {
+                return i;
+            }
+            std::string value(length, '\0');
+            if(std::fread(&value[0], 1, length, file) != length) {
+                throw SpillException("read from");
+            }
+            values.push_back(std::move(value));
+        }
+        return count;
+    }
+};
+
+// A sorted run that was written to a temporary file, which is deleted when
+// the run is. Written in one go or a buffer at a time, then read back a
+// buffer at a time.
+template<typename T>
+class SpilledRun {
+
+public:
+    SpilledRun() : file_(std::tmpfile(), &std::fclose) {
+        if(!file_) {
+            throw SpillException("create");
+        }
+    }
+
+    explicit SpilledRun(const std::vector<T>& sorted) : SpilledRun() {
+        write(sorted);
+        finish();
+    }
+
+    void write(const std::vector<T>& sorted) {
+        if(!SpillCodec<T>::write(file_.get(), sorted.data(), sorted.size())) {
+            throw SpillException("write to");
+        }
+    }
+
+    // Ends writing and goes back to the start for reading.
+    void finish() {
+        if(std::fflush(file_.get()) != 0) {
+            throw SpillException("write to");
+        }
+        std::rewind(file_.get());
+    }
+
+    // Returns the next element, or nullptr at the end of the run.
+    T* next(size_t buffer_size) {
+        if(position_ == buffer_.size()) {
+            buffer_.clear();
+            position_ = 0;
+            if(SpillCodec<T>::read(file_.get(), buffer_, buffer_size) == 0) {
+                if(std::ferror(file_.get())) {
+                    throw SpillException("read from");
+                }
+                return nullptr;
+            }
+        }
+        return &buffer_[position_++];
+    }
+
+private:
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file_;
+    std::vector<T> buffer_;
+    size_t position_ = 0;
+
+};
+
+// Sorts more elements than fit in memory. The source is cut into runs of
+// about memory_budget bytes, each sorted in memory and written to a
+// temporary file in a compact binary format. The last run stays in memory.
+// The runs are then merged lazily, a buffer at a time from each file, as
+// elements are read. A source that fits within the budget is simply sorted
+// in memory. Not stable.
+//
+// No merge reads from more than max_fan_in runs, which bounds both the
+// number of open files and how thin the budget is spread over read
+// buffers. Whenever max_fan_in runs of the same generation pile up while
+// spilling, they are merged into one run of the next generation, and
+// before the final merge the smallest runs are merged until few enough
+// are left.
+template<typename T, typename Less>
+class ExternalSort : public StreamProvider<T> {
+
+public:
+    static constexpr size_t max_fan_in = 64;
+
+    ExternalSort(StreamProviderPtr<T> source, Less&& less, size_t memory_budget)
+        : source_(std::move(source)), less_(less), memory_budget_(memory_budget) {}
+
+    T& value() override {
+        return *current_;
+    }
+
+    bool advance_impl() override {
+        if(first_) {
+            first_ = false;
+            spill_runs();
+        }
+        if(heap_.empty()) {
+            current_.reset();
+            return false;
+        }
+        std::pop_heap(heap_.begin(), heap_.end(), heap_order());
+        Head head = heap_.back();
+        heap_.pop_back();
+        // Taken out before the run's buffer is refilled under it.
+        current_.emplace(std::move(*head.value));
+        remaining_--;
+        T* next = pull(head.run);
+        if(next) {
+            heap_.push_back({next, head.run});
+            std::push_heap(heap_.begin(), heap_.end(), heap_order());
+        }
+        return true;
+    }
+
+    size_t size_hint() const override {
+        return first_ ? source_->size_hint() : remaining_;
+    }
+
+    bool exact_size() const override {
+        return !first_ || source_->exact_size();
+    }
+
+    PrintInfo print(std::ostream& os, int indent) const override {
+        this->print_indent(os, indent);
+        os << "ExternalSort[" << memory_budget_ << " bytes]:\n";
+        return source_->print(os, indent + 1).addStage();
+    }
+
+private:
+    // The next element of a run. The run past the last spilled one is the
+    // one held in memory.
+    struct Head {
+        T* value;
+        size_t run;
+    };
+
+    // Runs written straight from memory are generation 0, and a merge of
+    // runs of generation g is of generation g + 1.
+    struct Run {
+        std::unique_ptr<SpilledRun<T>> file;
+        size_t generation;
+    };
+
+    StreamProviderPtr<T> source_;
+    Less less_;
+    size_t memory_budget_;
+    std::vector<Run> spilled_;
+    std::vector<T> in_memory_;
+    size_t in_memory_position_ = 0;
+    std::vector<Head> heap_;
+    size_t buffer_size_ = 0;
+    Slot<T> current_;
+    size_t remaining_ = 0;
+    bool first_ = true;
+
+    auto heap_order() {
+        return [this](const Head& left, const Head& right) {
+            return less_(*right.value, *left.value);
+        };
+    }
+
+    void spill_runs() {
+        std::vector<T> batch;
+        size_t used = 0, total = 0;
+        size_t pulled;
+        reserve_run(sizeof(T));
+        do {
+            batch.clear();
+            pulled = source_->advance_batch(batch, batch_size);
+            for(auto&& element : batch) {
+                size_t footprint = SpillCodec<T>::footprint(element);
+                used += footprint;
+                total += footprint;
+                in_memory_.push_back(std::move(element));
+                remaining_++;
+                if(used >= memory_budget_) {
+                    spill_in_memory(total / remaining_);
+                    reserve_run(total / remaining_);
+                    used = 0;
+                }
+            }
+        } while(pulled == batch_size);
+
+        size_t average = remaining_ > 0 ? std::max<size_t>(1, total / remaining_) : 1;
+        // Leave at least half the budget for reading the spilled runs back.
+        if(!spilled_.empty() && used > memory_budget_ / 2) {
+            spill_in_memory(average);
+            used = 0;
+        }
+        // Merge the runs of the earliest generations, which are the
+        // smallest, until the final merge is within max_fan_in.
+        while(spilled_.size() + 1 > max_fan_in) {
+            std::sort(spilled_.begin(), spilled_.end(), [](const Run& left, const Run& right) {
+                return left.generation > right.generation;
+            });
+            size_t count = std::min(max_fan_in, spilled_.size() + 2 - max_fan_in);
+            merge_last(count, memory_budget_ - used, average);
+        }
+        detail::sort_values(in_memory_, less_, false);
+
+        // The spilled runs share what the last run leaves of the budget to
+        // read back into.
+        buffer_size_ = read_buffer_size(memory_budget_ - std::min(used, memory_budget_),
+                                        spilled_.size(), average);
+        for(size_t run = 0; run <= spilled_.size(); run++) {
+            if(T* value = pull(run)) {
+                heap_.push_back({value, run});
+            }
+        }
+        std::make_heap(heap_.begin(), heap_.end(), heap_order());
+    }
+
+    // Sorts and spills the run held in memory, merging generations of runs
+    // that have piled up.
+    void spill_in_memory(size_t average) {
+        detail::sort_values(in_memory_, less_, false);
+        spilled_.push_back({std::unique_ptr<SpilledRun<T>>(new SpilledRun<T>(in_memory_)), 0});
+        std::vector<T>().swap(in_memory_);
+        for(size_t generation = 0; ; generation++) {
+            auto first = std::stable_partition(spilled_.begin(), spilled_.end(),
+                [generation](const Run& run) { return run.generation != generation; });
+            size_t count = spilled_.end() - first;
+            if(count < max_fan_in) {
+                break;
+            }
+            merge_last(count, memory_budget_, average);
+        }
+    }
+
+    // Reserves room for as many elements as fit in the budget, so a run's
+    // vector does not outgrow it by doubling. Until something has been
+    // spilled, a source without a size hint may well be tiny, so the first
+    // run is left to grow as usual.
+    void reserve_run(size_t average) {
+        size_t estimate = memory_budget_ / std::max<size_t>(1, average) + 1;
+        size_t hint = source_->size_hint();
+        if(hint > 0) {
+            estimate = std::min(estimate, hint);
+        } else if(spilled_.empty()) {
+            return;
+        }
+        in_memory_.reserve(estimate);
+    }
+
+    static size_t read_buffer_size(size_t memory, size_t runs, size_t average) {
+        return std::max<size_t>(
+            16, memory / std::max<size_t>(1, runs) / std::max<size_t>(1, average));
+    }
+
+    // Replaces the last count spilled runs with a single run merging them,
+    // with memory spread over their read buffers and the output.
+    void merge_last(size_t count, size_t memory, size_t average) {
+        size_t first = spilled_.size() - count;
+        size_t generation = 0;
+        for(size_t run = first; run < spilled_.size(); run++) {
+            generation = std::max(generation, spilled_[run].generation + 1);
+        }
+        size_t buffer_size = read_buffer_size(memory, count + 1, average);
+
+        std::vector<Head> heap;
+        for(size_t run = first; run < spilled_.size(); run++) {
+            if(T* value = spilled_[run].file->next(buffer_size)) {
+                heap.push_back({value, run});
+            }
+        }
+        std::make_heap(heap.begin(), heap.end(), heap_order());
+        std::unique_ptr<SpilledRun<T>> merged(new SpilledRun<T>());
+        std::vector<T> output;
+        output.reserve(buffer_size);
+        while(!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), heap_order());
+            Head head = heap.back();
+            heap.pop_back();
+            output.push_back(std::move(*head.value));
+            if(output.size() == buffer_size) {
+                merged->write(output);
+                output.clear();
+            }
+            if(T* next = spilled_[head.run].file->next(buffer_size)) {
+                heap.push_back({next, head.run});
+                std::push_heap(heap.begin(), heap.end(), heap_order());
+            }
+        }
+        merged->write(output);
+        merged->finish();
+        spilled_.erase(spilled_.begin() + first, spilled_.end());
+        spilled_.push_back({std::move(merged), generation});
+    }
+
+    T* pull(size_t run) {
+        if(run == spilled_.size()) {
+            if(in_memory_position_ == in_memory_.size()) {
+                return nullptr;
+            }
+            return &in_memory_[in_memory_position_++];
+        }
+        return spilled_[run].file->next(buffer_size_);
+    }
+
+};
+
+template<typename T, typename Less>
+constexpr size_t ExternalSort<T, Less>::max_fan_in;
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
@@ -6,26 +6,93 @@
 namespace stream {
 namespace provider {
 
-template<typename T, typename Predicate>
+namespace detail {
+
+// Advances source to the next element that keep accepts. Shared by the
+// stages that drop elements one at a time.
+template<typename Source, typename Keep>
+bool filter_next(Source& source, Keep&& keep) {
+    while(source->advance()) {
+        if(keep(source->value())) {
+            return true;
+        }
+        if(stream::detail::stop_flag()) {
+            return false;
+        }
+    }
+    return false;
+}
+
+// Appends up to n elements that keep accepts to batch, pulling from source
+// in batches and compacting the accepted ones in place.
+template<typename Source, typename T, typename Keep>
+size_t filter_batch(Source& source, std::vector<T>& batch, size_t n, Keep&& keep) {
+    size_t count = 0;
+    while(count < n) {
+        size_t start = batch.size();
+        size_t wanted = n - count;
+        size_t pulled = source->advance_batch(batch, wanted);
+        // Compact the accepted elements to the front of the new ones.
+        size_t kept = start;
+        try {
+            for(size_t i = start; i < batch.size(); i++) {
+                bool accepted = keep(batch[i]);
+                if(accepted) {
+                    if(kept != i) {
+                        batch[kept] = std::move(batch[i]);
+                    }
+                    kept++;
+                }
+                if(stream::detail::stop_flag()) {
+                    batch.erase(batch.begin() + kept, batch.end());
+                    return kept - start + count;
+                }
+            }
+        } catch(stream::StopStream&) {
+            batch.erase(batch.begin() + kept, batch.end());
+            throw;
+        }
+        batch.erase(batch.begin() + kept, batch.end());
+        count += kept - start;
+        if(pulled < wanted) {
+            break;
+        }
+    }
+    return count;
+}
+
+} /* namespace detail */
+
+template<typename T, typename Predicate, typename Source = StreamProviderPtr<T>>
 class Filter : public StreamProvider<T> {
 
 public:
-    Filter(StreamProviderPtr<T> source, Predicate&& predicate)
+    Filter(Source source, Predicate&& predicate)
         : source_(std::move(source)), predicate_(predicate) {}
 
+    T& value() override {
+        return source_->value();
+    }
+
     std::shared_ptr<T> get() override {
-        return current_;
+        return source_->get();
     }
 
     bool advance_impl() override {
-        while(source_->advance()) {
-            current_ = source_->get();
-            if(predicate_(*current_)) {
-                return true;
-            }
+        return detail::filter_next(source_, predicate_);
+    }
+
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        return detail::filter_batch(source_, batch, n, predicate_);
+    }
+
+    StreamProviderPtr<T> try_split() override {
+        auto prefix = source_->try_split();
+        if(!prefix) {
+            return nullptr;
         }
-        current_.reset();
-        return false;
+        return StreamProviderPtr<T>(
+            new Filter<T, Predicate>(std::move(prefix), Predicate(predicate_)));
     }
 
     PrintInfo print(std::ostream& os, int indent) const override {
@@ -35,9 +102,8 @@ public:
     }
 
 private:
-    StreamProviderPtr<T> source_;
+    Source source_;
     Predicate predicate_;
-    std::shared_ptr<T> current_;
 };
 
 } /* namespace provider */
@@ -15,28 +15,39 @@ public:
     FlatMap(StreamProviderPtr<In> source, Transform&& transform)
         : source_(std::move(source)), transform_(transform) {}
 
+    T& value() override {
+        return current_stream_.getSource()->value();
+    }
+
     std::shared_ptr<T> get() override {
-        return current_;
+        return current_stream_.getSource()->get();
     }
 
     bool advance_impl() override {
-        if(!first_ && current_stream_.getSource()->advance()) {
-            current_ = current_stream_.getSource()->get();
-            return true;
+        if(!first_) {
+            if(advance_current()) {
+                return true;
+            }
+            if(last_ || stream::detail::stop_flag()) {
+                return false;
+            }
         }
 
-        if(first_)
-            first_ = false;
+        first_ = false;
 
         while(source_->advance()) {
-            current_stream_ = std::move(transform_(std::move(*source_->get())));
-            if(current_stream_.getSource()->advance()) {
-                current_ = current_stream_.getSource()->get();
+            current_stream_ = transform_(std::move(source_->value()));
+            // A stop requested by the transform still hands out the stream
+            // it returned, then ends the flat map.
+            last_ = stream::detail::take_stop_request();
+            if(advance_current()) {
                 return true;
             }
+            if(last_ || stream::detail::stop_flag()) {
+                return false;
+            }
         }
 
-        current_.reset();
         return false;
     }
 
@@ -47,11 +58,19 @@ public:
     }
 
 private:
+    // A stop inside the current stream ends the flat map as well.
+    bool advance_current() {
+        size_t stops = stream::detail::stops_taken();
+        bool advanced = current_stream_.getSource()->advance();
+        stream::detail::relay_stop(stops);
+        return advanced;
+    }
+
     StreamProviderPtr<In> source_;
     Transform transform_;
     stream::Stream<T> current_stream_;
-    std::shared_ptr<T> current_;
     bool first_ = true;
+    bool last_ = false;
 
 };
 
@@ -15,12 +15,12 @@ public:
     Generate(Generator&& generator)
         : generator_(generator) {}
 
-    std::shared_ptr<T> get() override {
-        return current_;
+    T& value() override {
+        return *current_;
     }
 
     bool advance_impl() override {
-        current_ = std::make_shared<T>(generator_());
+        current_.emplace(generator_());
         return true;
     }
 
@@ -32,7 +32,7 @@ public:
 
 private:
     Generator generator_;
-    std::shared_ptr<T> current_;
+    Slot<T> current_;
 
 };
 
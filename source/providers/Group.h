@@ -5,55 +5,36 @@
 
 #include "../Utility.h"
 
+#include <array>
+
 namespace stream {
 namespace provider {
 
 namespace detail {
 
-struct IncompleteGroupError {};
-
-template<typename T>
-std::shared_ptr<T> next(StreamProviderPtr<T>& source) {
-    if(source->advance()) {
-        return source->get();
-    }
-    throw IncompleteGroupError();
-}
-
 template<typename T, size_t N>
 struct Grouper {
-    using Type = NTuple<T, N>;
-
-    static Type group(StreamProviderPtr<T>& source) {
-        auto sub = Grouper<T, N-1>::group(source);
-        auto curr = next(source);
-        return std::tuple_cat(sub, std::make_tuple<T>(std::move(*curr)));
+    using Type = std::conditional_t<N == 2, std::pair<T, T>, NTuple<T, N>>;
+
+    // Pulls the next N elements of source into result. Returns false, leaving
+    // result untouched, if the source runs out first.
+    template<typename Result>
+    static bool group(StreamProviderPtr<T>& source, Slot<Result>& result) {
+        std::array<Slot<T>, N> elements;
+        for(auto& element : elements) {
+            if(!source->advance()) {
+                return false;
+            }
+            element.emplace(std::move(source->value()));
+        }
+        result.emplace(make<Result>(elements, std::make_index_sequence<N>()));
+        return true;
     }
-};
 
-template<typename T>
-struct Grouper<T, 3> {
-    using Type = NTuple<T, 3>;
-
-    static Type group(StreamProviderPtr<T>& source) {
-        auto first = next(source);
-        auto second = next(source);
-        auto third = next(source);
-        return std::make_tuple<T, T, T>(std::move(*first),
-                                        std::move(*second),
-                                        std::move(*third));
-    }
-};
-
-template<typename T>
-struct Grouper<T, 2> {
-    using Type = std::pair<T, T>;
-
-    static Type group(StreamProviderPtr<T>& source) {
-        auto first = next(source);
-        auto second = next(source);
-        return std::make_pair<T, T>(std::move(*first),
-                                    std::move(*second));
+private:
+    template<typename Result, size_t... I>
+    static Result make(std::array<Slot<T>, N>& elements, std::index_sequence<I...>) {
+        return Result(std::move(*std::get<I>(elements))...);
     }
 };
 
@@ -71,18 +52,20 @@ public:
 
     Group(StreamProviderPtr<T> source) : source_(std::move(source)) {}
 
-    std::shared_ptr<GroupType> get() override {
-        return current_;
+    GroupType& value() override {
+        return *current_;
     }
 
     bool advance_impl() override {
-        try {
-            auto group = detail::Grouper<T, N>::group(source_);
-            current_ = std::make_shared<GroupType>(std::move(group));
-            return true;
-        } catch(detail::IncompleteGroupError& err) {
-            return false;
-        }
+        return detail::Grouper<T, N>::group(source_, current_);
+    }
+
+    size_t size_hint() const override {
+        return source_->size_hint() / N;
+    }
+
+    bool exact_size() const override {
+        return source_->exact_size();
     }
 
     PrintInfo print(std::ostream& os, int indent) const override {
@@ -93,7 +76,7 @@ public:
 
 private:
     StreamProviderPtr<T> source_;
-    std::shared_ptr<GroupType> current_;
+    Slot<GroupType> current_;
 
 };
 
@@ -0,0 +1,110 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_INLINE_H
+#define SCHEINERMAN_STREAM_PROVIDERS_INLINE_H
+
+#include "StreamProvider.h"
+
+namespace stream {
+namespace provider {
+
+// Holds a provider by value in place of a StreamProviderPtr. Calls made
+// through it name the concrete provider, so they are bound statically and a
+// chain of inlined stages compiles down to a single loop. Moving it into a
+// StreamProviderPtr type-erases the chain.
+template<typename P>
+class Inline {
+
+public:
+    using element_type = typename P::element_type;
+
+    explicit Inline(P&& provider) : provider_(std::move(provider)) {}
+
+    Inline<P>* operator-> () {
+        return this;
+    }
+
+    const Inline<P>* operator-> () const {
+        return this;
+    }
+
+    bool advance() {
+        if(stopped_) {
+            return false;
+        }
+        bool advanced;
+        try {
+            advanced = provider_.P::advance_impl();
+        } catch(stream::StopStream&) {
+            advanced = false;
+            stream::detail::stop_flag() = true;
+        }
+        stopped_ = stream::detail::take_stop_request() || !advanced;
+        return advanced;
+    }
+
+    element_type& value() {
+        return provider_.P::value();
+    }
+
+    std::shared_ptr<element_type> get() {
+        return provider_.P::get();
+    }
+
+    size_t advance_batch(std::vector<element_type>& batch, size_t n) {
+        if(stopped_) {
+            return 0;
+        }
+        size_t start = batch.size();
+        size_t count;
+        try {
+            count = provider_.P::advance_batch_impl(batch, n);
+        } catch(stream::StopStream&) {
+            count = batch.size() - start;
+            stream::detail::stop_flag() = true;
+        }
+        stopped_ = stream::detail::take_stop_request() || count < n;
+        return count;
+    }
+
+    size_t advance_by(size_t n) {
+        if(stopped_) {
+            return 0;
+        }
+        size_t count = provider_.P::advance_by_impl(n);
+        stopped_ = stream::detail::take_stop_request() || count < n;
+        return count;
+    }
+
+    StreamProviderPtr<element_type> try_split() {
+        return provider_.P::try_split();
+    }
+
+    size_t size_hint() const {
+        return provider_.P::size_hint();
+    }
+
+    bool exact_size() const {
+        return provider_.P::exact_size();
+    }
+
+    PrintInfo print(std::ostream& os, int indent) const {
+        return provider_.P::print(os, indent);
+    }
+
+    P& provider() {
+        return provider_;
+    }
+
+    operator StreamProviderPtr<element_type>() && {
+        return StreamProviderPtr<element_type>(new P(std::move(provider_)));
+    }
+
+private:
+    P provider_;
+    bool stopped_ = false;
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
@@ -16,18 +16,21 @@ class Iterate : public StreamProvider<T> {
 
 public:
     Iterate(T initial, Function&& function)
-        : function_(function), current_(std::make_shared<T>(initial)) {}
+        : function_(function) {
+        state_.emplace(std::move(initial));
+    }
 
-    std::shared_ptr<T> get() override {
-        return current_;
+    T& value() override {
+        return *current_;
     }
 
     bool advance_impl() override {
         if(first_) {
             first_ = false;
-            return true;
+        } else {
+            state_.emplace(function_(*state_));
         }
-        current_ = std::make_shared<T>(function_(*current_));
+        current_.emplace(*state_);
         return true;
     }
 
@@ -40,7 +43,8 @@ public:
 private:
     bool first_ = true;
     Function function_;
-    std::shared_ptr<T> current_;
+    Slot<T> state_;
+    Slot<T> current_;
 };
 
 } /* namespace provider */
@@ -5,6 +5,9 @@
 
 #include "../Utility.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace stream {
 namespace provider {
 
@@ -15,11 +18,15 @@ public:
     Iterator(Itr begin, Itr end)
         : current_(begin), end_(end) {}
 
-    std::shared_ptr<T> get() override {
-        return std::make_shared<T>(std::move(*current_));
+    T& value() override {
+        if(!value_.occupied()) {
+            value_.emplace(std::move(*current_));
+        }
+        return *value_;
     }
 
     bool advance_impl() override {
+        value_.reset();
         if(first_) {
             first_ = false;
             return current_ != end_;
@@ -28,6 +35,38 @@ public:
         return current_ != end_;
     }
 
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        value_.reset();
+        if(n == 0) {
+            return 0;
+        }
+        if(first_) {
+            first_ = false;
+        } else if(current_ != end_) {
+            ++current_;
+        }
+        if(current_ == end_) {
+            return 0;
+        }
+        return take(batch, n, Category{});
+    }
+
+    size_t advance_by_impl(size_t n) override {
+        return seek(n, Category{});
+    }
+
+    StreamProviderPtr<T> try_split() override {
+        return split(Category{});
+    }
+
+    size_t size_hint() const override {
+        return remaining(Category{});
+    }
+
+    bool exact_size() const override {
+        return std::is_base_of<std::random_access_iterator_tag, Category>::value;
+    }
+
     PrintInfo print(std::ostream& os, int indent) const override {
         this->print_indent(os, indent);
         os << "[iterator stream]\n";
@@ -35,9 +74,86 @@ public:
     }
 
 private:
+    using Category = typename std::iterator_traits<Itr>::iterator_category;
+
+    // Both overloads leave current_ on the last element taken.
+    size_t take(std::vector<T>& batch, size_t n, std::random_access_iterator_tag) {
+        size_t count = std::min<size_t>(n, end_ - current_);
+        batch.insert(batch.end(),
+                     std::make_move_iterator(current_),
+                     std::make_move_iterator(current_ + count));
+        current_ += count - 1;
+        return count;
+    }
+
+    size_t take(std::vector<T>& batch, size_t n, std::input_iterator_tag) {
+        size_t count = 0;
+        while(true) {
+            batch.push_back(std::move(*current_));
+            if(++count == n) {
+                return count;
+            }
+            Itr next = current_;
+            if(++next == end_) {
+                return count;
+            }
+            current_ = next;
+        }
+    }
+
+    size_t seek(size_t n, std::random_access_iterator_tag) {
+        value_.reset();
+        if(n == 0) {
+            return 0;
+        }
+        Itr next = current_;
+        if(first_) {
+            first_ = false;
+        } else if(current_ != end_) {
+            ++next;
+        }
+        size_t available = end_ - next;
+        if(n > available) {
+            current_ = end_;
+            return available;
+        }
+        current_ = next + (n - 1);
+        return n;
+    }
+
+    size_t seek(size_t n, std::input_iterator_tag) {
+        return StreamProvider<T>::advance_by_impl(n);
+    }
+
+    StreamProviderPtr<T> split(std::random_access_iterator_tag) {
+        if(!first_ || end_ - current_ < 2) {
+            return nullptr;
+        }
+        Itr middle = current_ + (end_ - current_) / 2;
+        StreamProviderPtr<T> prefix(new Iterator<T, Itr>(current_, middle));
+        current_ = middle;
+        return prefix;
+    }
+
+    StreamProviderPtr<T> split(std::input_iterator_tag) {
+        return nullptr;
+    }
+
+    size_t remaining(std::random_access_iterator_tag) const {
+        if(first_) {
+            return end_ - current_;
+        }
+        return current_ == end_ ? 0 : end_ - current_ - 1;
+    }
+
+    size_t remaining(std::input_iterator_tag) const {
+        return 0;
+    }
+
     bool first_ = true;
     Itr current_;
     Itr end_;
+    Slot<T> value_;
 
 };
 
@@ -8,26 +8,60 @@
 namespace stream {
 namespace provider {
 
-template<typename T, typename Transform, typename In>
+template<typename T, typename Transform, typename In,
+         typename Source = StreamProviderPtr<In>>
 class Map : public StreamProvider<T> {
 
 public:
-    Map(StreamProviderPtr<In> source, Transform&& transform)
+    Map(Source source, Transform&& transform)
         : source_(std::move(source)), transform_(transform) {}
 
-    std::shared_ptr<T> get() override {
-        return current_;
+    T& value() override {
+        return *current_;
     }
 
     bool advance_impl() override {
         if(source_->advance()) {
-            current_ = std::make_shared<T>(transform_(std::move(*source_->get())));
+            current_.emplace(transform_(std::move(source_->value())));
             return true;
         }
         current_.reset();
         return false;
     }
 
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        current_.reset();
+        input_.clear();
+        input_.reserve(n);
+        size_t count = source_->advance_batch(input_, n);
+        batch.reserve(batch.size() + count);
+        for(size_t i = 0; i < count; i++) {
+            batch.push_back(transform_(std::move(input_[i])));
+            if(stream::detail::stop_flag()) {
+                return i + 1;
+            }
+        }
+        return count;
+    }
+
+    StreamProviderPtr<T> try_split() override {
+        auto prefix = source_->try_split();
+        if(!prefix) {
+            return nullptr;
+        }
+        return StreamProviderPtr<T>(
+            new Map<T, Transform, In>(std::move(prefix), Transform(transform_)));
+    }
+
+    size_t size_hint() const override {
+        return source_->size_hint();
+    }
+
+    // The transform may request a stop, so the length is never certain.
+    bool exact_size() const override {
+        return false;
+    }
+
     PrintInfo print(std::ostream& os, int indent) const override {
         this->print_indent(os, indent);
         os << "Map:\n";
@@ -35,9 +69,10 @@ public:
     }
 
 private:
-    StreamProviderPtr<In> source_;
+    Source source_;
     Transform transform_;
-    std::shared_ptr<T> current_;
+    Slot<T> current_;
+    std::vector<In> input_;
 
 };
 
@@ -0,0 +1,99 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_OPEN_HASH_SET_H
+#define SCHEINERMAN_STREAM_PROVIDERS_OPEN_HASH_SET_H
+
+#include "Slot.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace stream {
+namespace provider {
+
+// A hash set with open addressing and linear probing, storing elements in
+// one flat array next to their hash codes. Equality is only checked when
+// the full hash codes match, and growing never calls hash again. Kept at
+// most half full.
+template<typename T, typename Hash, typename Equal>
+class OpenHashSet {
+
+public:
+    OpenHashSet(const Hash& hash, const Equal& equal)
+        : hash_(hash), equal_(equal), codes_(initial_capacity, empty), slots_(initial_capacity) {}
+
+    // Adds a copy of value, returning false if an equal element was there.
+    bool insert(const T& value) {
+        size_t code = hash_code(value);
+        size_t mask = codes_.size() - 1;
+        size_t index = code & mask;
+        while(codes_[index] != empty) {
+            if(codes_[index] == code && equal_(*slots_[index], value)) {
+                return false;
+            }
+            index = (index + 1) & mask;
+        }
+        codes_[index] = code;
+        slots_[index].emplace(value);
+        if(++size_ * 2 > codes_.size()) {
+            grow();
+        }
+        return true;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+private:
+    static constexpr size_t empty = 0;
+    static constexpr size_t initial_capacity = 16;
+
+    Hash hash_;
+    Equal equal_;
+    std::vector<size_t> codes_;
+    std::vector<Slot<T>> slots_;
+    size_t size_ = 0;
+
+    // Hash codes are never 0, which marks an empty slot.
+    size_t hash_code(const T& value) {
+        // Mixes the bits so that weak hashes, such as the identity
+        // std::hash of integers, still spread over the low bits.
+        std::uint64_t mixed = hash_(value);
+        mixed ^= mixed >> 33;
+        mixed *= 0xff51afd7ed558ccdULL;
+        mixed ^= mixed >> 33;
+        size_t code = static_cast<size_t>(mixed);
+        return code == empty ? 1 : code;
+    }
+
+    void grow() {
+        std::vector<size_t> codes(codes_.size() * 2, empty);
+        std::vector<Slot<T>> slots(slots_.size() * 2);
+        size_t mask = codes.size() - 1;
+        for(size_t i = 0; i < codes_.size(); i++) {
+            if(codes_[i] == empty) {
+                continue;
+            }
+            size_t index = codes_[i] & mask;
+            while(codes[index] != empty) {
+                index = (index + 1) & mask;
+            }
+            codes[index] = codes_[i];
+            slots[index].emplace(std::move(*slots_[i]));
+        }
+        codes_.swap(codes);
+        slots_.swap(slots);
+    }
+
+};
+
+template<typename T, typename Hash, typename Equal>
+constexpr size_t OpenHashSet<T, Hash, Equal>::empty;
+
+template<typename T, typename Hash, typename Equal>
+constexpr size_t OpenHashSet<T, Hash, Equal>::initial_capacity;
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
@@ -27,24 +27,23 @@ private:
 public:
     Overlap(StreamProviderPtr<T> source) : source_(std::move(source)) {}
 
-    std::shared_ptr<Tuple> get() override {
-        return current_;
+    Tuple& value() override {
+        return *current_;
     }
 
     bool advance_impl() override {
         if(first_) {
             first_ = false;
-            try {
-                current_ = std::make_shared<Tuple>(detail::Grouper<T, N>::group(source_));
+            if(detail::Grouper<T, N>::group(source_, window_)) {
+                current_.emplace(*window_);
                 return true;
-            } catch(detail::IncompleteGroupError& e) {
-                return false;
             }
+            return false;
         }
 
-        if(source_->advance()) {
-            current_ = std::make_shared<Tuple>(
-                rotate(std::move(*current_), std::move(*source_->get())));
+        if(window_.occupied() && source_->advance()) {
+            window_.emplace(rotate(std::move(*window_), std::move(source_->value())));
+            current_.emplace(*window_);
             return true;
         }
         current_.reset();
@@ -60,7 +59,8 @@ public:
 private:
     bool first_ = true;
     StreamProviderPtr<T> source_;
-    std::shared_ptr<Tuple> current_;
+    Slot<Tuple> window_;
+    Slot<Tuple> current_;
 
 };
 
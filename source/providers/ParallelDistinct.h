@@ -0,0 +1,102 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_PARALLEL_DISTINCT_H
+#define SCHEINERMAN_STREAM_PROVIDERS_PARALLEL_DISTINCT_H
+
+#include "StreamProvider.h"
+#include "ShardedSet.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace stream {
+namespace provider {
+
+// Removes duplicates with a ShardedSet built on the first advance, then
+// streams out one shard after another.
+template<typename T, typename Hash, typename Equal>
+class ParallelDistinct : public StreamProvider<T> {
+
+public:
+    ParallelDistinct(StreamProviderPtr<T> source, const Hash& hash,
+                     const Equal& equal, exec::Executor& executor)
+        : source_(std::move(source)), set_(hash, equal, executor) {}
+
+    T& value() override {
+        return *current_;
+    }
+
+    bool advance_impl() override {
+        build();
+        if(!next_shard()) {
+            current_.reset();
+            return false;
+        }
+        current_.emplace(std::move(set_.shards()[shard_][position_++]));
+        remaining_--;
+        return true;
+    }
+
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        build();
+        current_.reset();
+        size_t count = 0;
+        while(count < n && next_shard()) {
+            auto& shard = set_.shards()[shard_];
+            size_t available = std::min(n - count, shard.size() - position_);
+            auto begin = shard.begin() + position_;
+            batch.insert(batch.end(), std::make_move_iterator(begin),
+                         std::make_move_iterator(begin + available));
+            position_ += available;
+            remaining_ -= available;
+            count += available;
+        }
+        return count;
+    }
+
+    size_t size_hint() const override {
+        return first_ ? 0 : remaining_;
+    }
+
+    bool exact_size() const override {
+        return !first_;
+    }
+
+    PrintInfo print(std::ostream& os, int indent) const override {
+        this->print_indent(os, indent);
+        os << "ParallelDistinct:\n";
+        return source_->print(os, indent + 1).addStage();
+    }
+
+private:
+    StreamProviderPtr<T> source_;
+    ShardedSet<T, Hash, Equal> set_;
+    Slot<T> current_;
+    size_t shard_ = 0;
+    size_t position_ = 0;
+    size_t remaining_ = 0;
+    bool first_ = true;
+
+    void build() {
+        if(first_) {
+            set_.build(source_, true);
+            remaining_ = set_.size();
+            first_ = false;
+        }
+    }
+
+    // Skips past used up shards. Returns false once there are none left.
+    bool next_shard() {
+        auto& shards = set_.shards();
+        while(shard_ < shards.size() && position_ == shards[shard_].size()) {
+            std::vector<T>().swap(shards[shard_]);
+            shard_++;
+            position_ = 0;
+        }
+        return shard_ < shards.size();
+    }
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
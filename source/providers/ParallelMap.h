@@ -0,0 +1,304 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_PARALLEL_MAP_H
+#define SCHEINERMAN_STREAM_PROVIDERS_PARALLEL_MAP_H
+
+#include "StreamProvider.h"
+
+#include "../StreamExecutor.h"
+#include "../Utility.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace stream {
+namespace provider {
+
+// How ParallelMap turns each input element into output. apply() returns
+// false if the stream was asked to stop, in which case the element still
+// contributes its output but the elements after it are left alone.
+
+// Each element becomes one result of the transform.
+struct MapStep {
+    static constexpr bool one_to_one = true;
+    static constexpr size_t chunk_size = 64;
+
+    static const char* name() {
+        return "ParallelMap";
+    }
+
+    template<typename Transform, typename Element, typename T>
+    static bool apply(Transform& transform, Element&& element,
+                      std::vector<T>& output) {
+        output.push_back(transform(std::forward<Element>(element)));
+        return !stream::detail::take_stop_request();
+    }
+};
+
+// The transform is a predicate, and elements it accepts are kept.
+struct FilterStep {
+    static constexpr bool one_to_one = false;
+    static constexpr size_t chunk_size = 64;
+
+    static const char* name() {
+        return "ParallelFilter";
+    }
+
+    template<typename Predicate, typename Element, typename T>
+    static bool apply(Predicate& predicate, Element&& element,
+                      std::vector<T>& output) {
+        if(predicate(element)) {
+            output.push_back(std::forward<Element>(element));
+        }
+        return !stream::detail::take_stop_request();
+    }
+};
+
+// The transform returns a stream, which is drained into the output. Chunks
+// are small since each element may expand into many.
+struct FlatMapStep {
+    static constexpr bool one_to_one = false;
+    static constexpr size_t chunk_size = 4;
+
+    static const char* name() {
+        return "ParallelFlatMap";
+    }
+
+    template<typename Transform, typename Element, typename T>
+    static bool apply(Transform& transform, Element&& element,
+                      std::vector<T>& output) {
+        auto inner = transform(std::forward<Element>(element));
+        bool stopped = stream::detail::take_stop_request();
+        // A stop inside the returned stream ends the flat map as well.
+        size_t stops = stream::detail::stops_taken();
+        auto& source = inner.getSource();
+        while(source->advance_batch(output, batch_size) == batch_size) {}
+        return !stopped && stream::detail::stops_taken() == stops;
+    }
+};
+
+// Applies the transform on an executor. The source is read in chunks on the
+// consuming thread and each chunk is transformed by a separate task. At most
+// parallelism chunks are in flight, and every one of them has a transform of
+// its own. When Ordered, chunks are handed out strictly in input order, so
+// the window of pending chunks doubles as the reorder buffer; otherwise
+// whichever chunk finishes first goes first. Step decides what a chunk's
+// elements turn into.
+template<typename T, typename Transform, typename In,
+         bool Ordered = true, typename Step = MapStep>
+class ParallelMap : public StreamProvider<T> {
+
+public:
+    ParallelMap(StreamProviderPtr<In> source, Transform&& transform,
+                exec::Executor& executor, size_t parallelism,
+                size_t chunk_size = Step::chunk_size)
+        : source_(std::move(source)),
+          chunk_size_(chunk_size),
+          group_(executor) {
+        size_t slots = parallelism == 0 ? executor.concurrency() : parallelism;
+        for(size_t i = 0; i < slots; i++) {
+            transforms_.emplace_back(transform);
+            free_.push_back(slots - 1 - i);
+        }
+    }
+
+    // Chunks no worker has started on are dropped rather than transformed,
+    // so stopping early, as first() or limit() do, only waits for the ones
+    // already running.
+    ~ParallelMap() {
+        group_.cancel();
+    }
+
+    T& value() override {
+        return *current_;
+    }
+
+    bool advance_impl() override {
+        while(!chunk_ || position_ == chunk_->output.size()) {
+            if(!next_chunk()) {
+                current_.reset();
+                return false;
+            }
+        }
+        current_.emplace(std::move(chunk_->output[position_++]));
+        return true;
+    }
+
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        current_.reset();
+        size_t count = 0;
+        while(count < n) {
+            if(!chunk_ || position_ == chunk_->output.size()) {
+                if(!next_chunk()) {
+                    break;
+                }
+                continue;
+            }
+            size_t available = std::min(n - count, chunk_->output.size() - position_);
+            batch.reserve(batch.size() + available);
+            for(size_t i = 0; i < available; i++) {
+                batch.push_back(std::move(chunk_->output[position_++]));
+            }
+            count += available;
+        }
+        return count;
+    }
+
+    size_t size_hint() const override {
+        if(!Step::one_to_one) {
+            return 0;
+        }
+        size_t buffered = chunk_ ? chunk_->output.size() - position_ : 0;
+        for(auto& chunk : window_) {
+            buffered += chunk->size;
+        }
+        return source_->size_hint() + buffered;
+    }
+
+    // The transform may request a stop, so the length is never certain.
+    bool exact_size() const override {
+        return false;
+    }
+
+    PrintInfo print(std::ostream& os, int indent) const override {
+        this->print_indent(os, indent);
+        os << Step::name() << (Ordered ? "" : " (unordered)") << ":\n";
+        return source_->print(os, indent + 1).addStage();
+    }
+
+private:
+    struct Chunk {
+        std::vector<In> input;
+        std::vector<T> output;
+        size_t size = 0;
+        size_t slot = 0;
+        bool ready = false;
+        bool stopped = false;
+        std::exception_ptr error;
+    };
+
+    using ChunkPtr = std::shared_ptr<Chunk>;
+
+    StreamProviderPtr<In> source_;
+    size_t chunk_size_;
+    std::vector<Transform> transforms_;
+    std::vector<size_t> free_;
+    std::deque<ChunkPtr> window_;
+    bool exhausted_ = false;
+    bool halted_ = false;
+    std::exception_ptr error_;
+    ChunkPtr chunk_;
+    size_t position_ = 0;
+    Slot<T> current_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    // Declared last so it is destroyed first, waiting for tasks that still
+    // refer to the members above.
+    exec::TaskGroup group_;
+
+    void fill() {
+        while(!exhausted_ && !halted_ && !free_.empty()) {
+            auto chunk = std::make_shared<Chunk>();
+            chunk->input.reserve(chunk_size_);
+            chunk->size = source_->advance_batch(chunk->input, chunk_size_);
+            exhausted_ = chunk->size < chunk_size_;
+            if(chunk->size == 0) {
+                return;
+            }
+            chunk->slot = free_.back();
+            free_.pop_back();
+            window_.push_back(chunk);
+            Transform& transform = transforms_[chunk->slot];
+            group_.run([this, chunk, &transform] { transform_chunk(*chunk, transform); });
+        }
+    }
+
+    void transform_chunk(Chunk& chunk, Transform& transform) {
+        try {
+            chunk.output.reserve(chunk.size);
+            for(auto&& element : chunk.input) {
+                if(!Step::apply(transform, std::move(element), chunk.output)) {
+                    chunk.stopped = true;
+                    break;
+                }
+            }
+        } catch(stream::StopStream&) {
+            chunk.stopped = true;
+        } catch(...) {
+            chunk.error = std::current_exception();
+        }
+        chunk.input.clear();
+        std::lock_guard<std::mutex> lock(mutex_);
+        chunk.ready = true;
+        ready_.notify_all();
+    }
+
+    // The next chunk to hand out if it is ready, or else the end of the
+    // candidates. Must hold mutex_.
+    typename std::deque<ChunkPtr>::iterator find_ready(
+            typename std::deque<ChunkPtr>::iterator& last) {
+        last = Ordered ? std::next(window_.begin()) : window_.end();
+        return std::find_if(window_.begin(), last,
+                            [](const ChunkPtr& chunk) { return chunk->ready; });
+    }
+
+    // Removes the next chunk to hand out from the window, waiting until it
+    // is ready. Transforms chunks that no worker has started on in the
+    // meantime.
+    ChunkPtr take_ready() {
+        typename std::deque<ChunkPtr>::iterator last;
+        while(true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                auto ready = find_ready(last);
+                if(ready != last) {
+                    ChunkPtr chunk = std::move(*ready);
+                    window_.erase(ready);
+                    return chunk;
+                }
+            }
+            if(!group_.run_pending()) {
+                // Every chunk in the window has started, so one of them
+                // finishing will notify.
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [&] { return find_ready(last) != last; });
+            }
+        }
+    }
+
+    // Moves on to the next chunk once it is ready, then tops up the window
+    // so the workers stay busy. Returns false at the end.
+    bool next_chunk() {
+        chunk_.reset();
+        position_ = 0;
+        if(error_) {
+            std::exception_ptr error = error_;
+            error_ = nullptr;
+            std::rethrow_exception(error);
+        }
+        if(halted_) {
+            return false;
+        }
+        fill();
+        if(window_.empty()) {
+            return false;
+        }
+        ChunkPtr chunk = take_ready();
+        free_.push_back(chunk->slot);
+        // The elements before a failure or stop request still come out.
+        error_ = chunk->error;
+        halted_ = chunk->stopped || chunk->error;
+        chunk_ = std::move(chunk);
+        fill();
+        return true;
+    }
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_PARALLEL_SORT_H
+#define SCHEINERMAN_STREAM_PROVIDERS_PARALLEL_SORT_H
+
+#include "StreamProvider.h"
+
+#include "../StreamExecutor.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace stream {
+namespace provider {
+
+// Collects the source into one vector on the first advance and sorts it on
+// an executor: each thread sorts a run of its own, then neighbouring runs
+// are merged in pairs, one round at a time, until a single run is left.
+template<typename T, typename Less>
+class ParallelSort : public StreamProvider<T> {
+
+public:
+    ParallelSort(StreamProviderPtr<T> source, Less&& less,
+                 exec::Executor& executor)
+        : source_(std::move(source)), less_(less), executor_(executor) {}
+
+    T& value() override {
+        return *current_;
+    }
+
+    bool advance_impl() override {
+        sort();
+        if(position_ == sorted_.size()) {
+            current_.reset();
+            return false;
+        }
+        current_.emplace(std::move(sorted_[position_++]));
+        return true;
+    }
+
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        sort();
+        current_.reset();
+        size_t count = std::min(n, sorted_.size() - position_);
+        auto begin = sorted_.begin() + position_;
+        batch.insert(batch.end(), std::make_move_iterator(begin),
+                     std::make_move_iterator(begin + count));
+        position_ += count;
+        return count;
+    }
+
+    size_t size_hint() const override {
+        return first_ ? source_->size_hint() : sorted_.size() - position_;
+    }
+
+    bool exact_size() const override {
+        return !first_ || source_->exact_size();
+    }
+
+    PrintInfo print(std::ostream& os, int indent) const override {
+        this->print_indent(os, indent);
+        os << "ParallelSort:\n";
+        return source_->print(os, indent + 1).addStage();
+    }
+
+private:
+    // Below this many elements per thread, splitting the work costs more
+    // than it saves.
+    static constexpr size_t min_run = 4096;
+
+    StreamProviderPtr<T> source_;
+    Less less_;
+    exec::Executor& executor_;
+    std::vector<T> sorted_;
+    size_t position_ = 0;
+    Slot<T> current_;
+    bool first_ = true;
+
+    void sort() {
+        if(!first_) {
+            return;
+        }
+        first_ = false;
+        sorted_.reserve(source_->size_hint());
+        while(source_->advance_batch(sorted_, batch_size) == batch_size) {}
+
+        size_t runs = std::min(executor_.concurrency(), sorted_.size() / min_run);
+        if(runs <= 1) {
+            std::sort(sorted_.begin(), sorted_.end(), less_);
+            return;
+        }
+
+        std::vector<size_t> bounds;
+        for(size_t i = 0; i <= runs; i++) {
+            bounds.push_back(sorted_.size() * i / runs);
+        }
+        {
+            exec::TaskGroup group(executor_);
+            for(size_t i = 0; i < runs; i++) {
+                group.run([this, &bounds, i] {
+                    std::sort(sorted_.begin() + bounds[i],
+                              sorted_.begin() + bounds[i + 1], Less(less_));
+                });
+            }
+            group.wait();
+        }
+        while(bounds.size() > 2) {
+            std::vector<size_t> merged;
+            exec::TaskGroup group(executor_);
+            for(size_t i = 0; i + 2 < bounds.size(); i += 2) {
+                group.run([this, &bounds, i] {
+                    std::inplace_merge(sorted_.begin() + bounds[i],
+                                       sorted_.begin() + bounds[i + 1],
+                                       sorted_.begin() + bounds[i + 2], Less(less_));
+                });
+                merged.push_back(bounds[i]);
+            }
+            if(bounds.size() % 2 == 0) {
+                // An odd run out waits for the next round.
+                merged.push_back(bounds[bounds.size() - 2]);
+            }
+            merged.push_back(bounds.back());
+            group.wait();
+            bounds.swap(merged);
+        }
+    }
+
+};
+
+template<typename T, typename Less>
+constexpr size_t ParallelSort<T, Less>::min_run;
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
@@ -13,24 +13,26 @@ public:
     PartialSum(StreamProviderPtr<T> source, Adder&& add)
         : source_(std::move(source)), add_(add) {}
 
-    std::shared_ptr<T> get() override {
-        return current_;
+    T& value() override {
+        return *current_;
     }
 
     bool advance_impl() override {
         if(first_) {
             first_ = false;
             if(source_->advance()) {
-                current_ = source_->get();
+                total_.emplace(std::move(source_->value()));
+                current_.emplace(*total_);
                 return true;
             }
             return false;
         }
 
         if(source_->advance()) {
-            current_ = std::make_shared<T>(add_(
-                std::move(*current_),
-                std::move(*source_->get())));
+            total_.emplace(add_(
+                std::move(*total_),
+                std::move(source_->value())));
+            current_.emplace(*total_);
             return true;
         }
         current_.reset();
@@ -46,7 +48,8 @@ public:
 private:
     StreamProviderPtr<T> source_;
     Adder add_;
-    std::shared_ptr<T> current_;
+    Slot<T> total_;
+    Slot<T> current_;
     bool first_ = true;
 };
 
@@ -6,24 +6,43 @@
 namespace stream {
 namespace provider {
 
-template<typename T, typename Action>
+template<typename T, typename Action, typename Source = StreamProviderPtr<T>>
 class Peek : public StreamProvider<T> {
 
 public:
-    Peek(StreamProviderPtr<T> source, Action&& action)
+    Peek(Source source, Action&& action)
         : source_(std::move(source)), action_(action) {}
 
+    T& value() override {
+        return source_->value();
+    }
+
     std::shared_ptr<T> get() override {
-        return current_;
+        return source_->get();
     }
 
     bool advance_impl() override {
         if(source_->advance()) {
-            current_ = source_->get();
-            action_(*current_);
+            action_(source_->value());
             return true;
         }
-        current_.reset();
+        return false;
+    }
+
+    StreamProviderPtr<T> try_split() override {
+        auto prefix = source_->try_split();
+        if(!prefix) {
+            return nullptr;
+        }
+        return StreamProviderPtr<T>(
+            new Peek<T, Action>(std::move(prefix), Action(action_)));
+    }
+
+    size_t size_hint() const override {
+        return source_->size_hint();
+    }
+
+    bool exact_size() const override {
         return false;
     }
 
@@ -34,9 +53,8 @@ public:
     }
 
 private:
-    StreamProviderPtr<T> source_;
+    Source source_;
     Action action_;
-    std::shared_ptr<T> current_;
 
 };
 
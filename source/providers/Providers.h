@@ -5,35 +5,51 @@
 
 #include "AdjacentDifference.h"
 #include "AdjacentDistinct.h"
+#include "AsyncBuffer.h"
 #include "Concatenate.h"
 #include "CycledContainer.h"
 #include "Difference.h"
 #include "Distinct.h"
+#include "DistinctUnordered.h"
 #include "DropWhile.h"
 #include "DynamicGroup.h"
 #include "DynamicOverlap.h"
 #include "Empty.h"
+#include "ExternalSort.h"
 #include "Filter.h"
 #include "FlatMap.h"
 #include "Generate.h"
 #include "Group.h"
+#include "Inline.h"
 #include "Intersection.h"
 #include "Iterate.h"
 #include "Iterator.h"
 #include "Map.h"
 #include "Merge.h"
+#include "OpenHashSet.h"
+#include "ParallelDistinct.h"
+#include "ParallelMap.h"
+#include "ParallelSort.h"
 #include "PartialSum.h"
 #include "Overlap.h"
 #include "Peek.h"
+#include "Randoms.h"
+#include "Range.h"
 #include "Recurrence.h"
 #include "Repeat.h"
+#include "Reservoir.h"
+#include "RingBuffer.h"
+#include "ShardedSet.h"
 #include "Singleton.h"
 #include "Slice.h"
 #include "Sort.h"
+#include "SortBy.h"
 #include "Stateful.h"
 #include "SymmetricDifference.h"
 #include "TakeWhile.h"
+#include "Tee.h"
 #include "Union.h"
+#include "View.h"
 #include "Zip.h"
 
 #endif
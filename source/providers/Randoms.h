@@ -0,0 +1,112 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_RANDOMS_H
+#define SCHEINERMAN_STREAM_PROVIDERS_RANDOMS_H
+
+#include "StreamProvider.h"
+
+#include <algorithm>
+
+namespace stream {
+namespace provider {
+
+// Random numbers from a counter-based engine, where element i is drawn by a
+// fresh copy of the distribution from substream i of the engine. Elements
+// therefore depend only on the seed and their index, so the stream can
+// skip ahead and split, either unbounded or with a known length, and gives
+// the same elements however it is divided up.
+template<typename T, template<typename> class Distribution, typename Engine>
+class Randoms : public StreamProvider<T> {
+
+public:
+    Randoms(const Engine& engine, const Distribution<T>& distribution, size_t count)
+        : engine_(engine), distribution_(distribution),
+          remaining_(count), bounded_(true) {}
+
+    Randoms(const Engine& engine, const Distribution<T>& distribution)
+        : engine_(engine), distribution_(distribution) {}
+
+    T& value() override {
+        return current_;
+    }
+
+    bool advance_impl() override {
+        if(bounded_) {
+            if(remaining_ == 0) {
+                return false;
+            }
+            remaining_--;
+        }
+        current_ = draw(index_++);
+        return true;
+    }
+
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        size_t count = bounded_ ? std::min(n, remaining_) : n;
+        batch.reserve(batch.size() + count);
+        for(size_t i = 0; i < count; i++) {
+            batch.push_back(draw(index_++));
+        }
+        if(bounded_) {
+            remaining_ -= count;
+        }
+        return count;
+    }
+
+    size_t advance_by_impl(size_t n) override {
+        size_t count = bounded_ ? std::min(n, remaining_) : n;
+        if(count == 0) {
+            return 0;
+        }
+        index_ += count;
+        current_ = draw(index_ - 1);
+        if(bounded_) {
+            remaining_ -= count;
+        }
+        return count;
+    }
+
+    StreamProviderPtr<T> try_split() override {
+        if(!bounded_ || remaining_ < 2) {
+            return nullptr;
+        }
+        size_t half = remaining_ / 2;
+        auto prefix = new Randoms<T, Distribution, Engine>(engine_, distribution_, half);
+        prefix->index_ = index_;
+        index_ += half;
+        remaining_ -= half;
+        return StreamProviderPtr<T>(prefix);
+    }
+
+    size_t size_hint() const override {
+        return bounded_ ? remaining_ : 0;
+    }
+
+    bool exact_size() const override {
+        return bounded_;
+    }
+
+    PrintInfo print(std::ostream& os, int indent) const override {
+        this->print_indent(os, indent);
+        os << "[random stream]\n";
+        return PrintInfo::Source();
+    }
+
+private:
+    Engine engine_;
+    Distribution<T> distribution_;
+    T current_{};
+    size_t index_ = 0;
+    size_t remaining_ = 0;
+    bool bounded_ = false;
+
+    T draw(size_t index) const {
+        Engine engine = engine_.substream(index);
+        Distribution<T> distribution = distribution_;
+        return distribution(engine);
+    }
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
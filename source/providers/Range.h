@@ -0,0 +1,103 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_RANGE_H
+#define SCHEINERMAN_STREAM_PROVIDERS_RANGE_H
+
+#include "StreamProvider.h"
+
+#include <algorithm>
+
+namespace stream {
+namespace provider {
+
+// An arithmetic progression of integers, either of a known length or
+// unbounded. Knowing its length up front lets it seek, report its size and
+// split.
+template<typename T>
+class Range : public StreamProvider<T> {
+
+public:
+    Range(T start, T increment, size_t count)
+        : next_(start), increment_(increment), remaining_(count), bounded_(true) {}
+
+    Range(T start, T increment)
+        : next_(start), increment_(increment) {}
+
+    T& value() override {
+        return current_;
+    }
+
+    bool advance_impl() override {
+        if(bounded_) {
+            if(remaining_ == 0) {
+                return false;
+            }
+            remaining_--;
+        }
+        current_ = next_;
+        next_ += increment_;
+        return true;
+    }
+
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        size_t count = bounded_ ? std::min(n, remaining_) : n;
+        batch.reserve(batch.size() + count);
+        for(size_t i = 0; i < count; i++) {
+            batch.push_back(next_);
+            next_ += increment_;
+        }
+        if(bounded_) {
+            remaining_ -= count;
+        }
+        return count;
+    }
+
+    size_t advance_by_impl(size_t n) override {
+        size_t count = bounded_ ? std::min(n, remaining_) : n;
+        if(count == 0) {
+            return 0;
+        }
+        current_ = next_ + increment_ * static_cast<T>(count - 1);
+        next_ = current_ + increment_;
+        if(bounded_) {
+            remaining_ -= count;
+        }
+        return count;
+    }
+
+    StreamProviderPtr<T> try_split() override {
+        if(!bounded_ || remaining_ < 2) {
+            return nullptr;
+        }
+        size_t half = remaining_ / 2;
+        StreamProviderPtr<T> prefix(new Range<T>(next_, increment_, half));
+        next_ += increment_ * static_cast<T>(half);
+        remaining_ -= half;
+        return prefix;
+    }
+
+    size_t size_hint() const override {
+        return bounded_ ? remaining_ : 0;
+    }
+
+    bool exact_size() const override {
+        return bounded_;
+    }
+
+    PrintInfo print(std::ostream& os, int indent) const override {
+        this->print_indent(os, indent);
+        os << "[range stream]\n";
+        return PrintInfo::Source();
+    }
+
+private:
+    T current_{};
+    T next_;
+    T increment_;
+    size_t remaining_ = 0;
+    bool bounded_ = false;
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
@@ -40,8 +40,8 @@ public:
     Recurrence(std::array<T, Order>&& arguments, Function&& function)
         : arguments_(arguments), function_(function) {}
 
-    std::shared_ptr<T> get() override {
-        return std::make_shared<T>(next_);
+    T& value() override {
+        return next_;
     }
 
     bool advance_impl() override {
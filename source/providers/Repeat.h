@@ -12,15 +12,16 @@ template<typename T>
 class Repeat : public StreamProvider<T> {
 
 public:
-    Repeat(const T& value) : value_(std::make_shared<T>(value)) {}
+    Repeat(const T& value) : value_(value) {}
 
-    Repeat(T&& value) : value_(std::make_shared<T>(value)) {}
+    Repeat(T&& value) : value_(std::move(value)) {}
 
-    std::shared_ptr<T> get() override {
-        return value_;
+    T& value() override {
+        return *current_;
     }
 
     bool advance_impl() override {
+        current_.emplace(value_);
         return true;
     }
 
@@ -31,7 +32,8 @@ public:
     }
 
 private:
-    std::shared_ptr<T> value_;
+    T value_;
+    Slot<T> current_;
 
 };
 
@@ -0,0 +1,157 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_RESERVOIR_H
+#define SCHEINERMAN_STREAM_PROVIDERS_RESERVOIR_H
+
+#include "StreamProvider.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace stream {
+namespace provider {
+
+// A uniform random sample of up to capacity of the elements seen so far.
+// Once full it works out how many elements to pass over before the next
+// one it keeps (Li's Algorithm L), so it draws random numbers only for
+// elements it keeps rather than for every element. Two reservoirs over
+// disjoint parts of a stream merge into a sample of the whole.
+template<typename T, typename Engine>
+class Reservoir {
+
+public:
+    Reservoir(size_t capacity, const Engine& engine)
+        : capacity_(capacity), engine_(engine) {
+        sample_.reserve(capacity);
+    }
+
+    void add(T&& element) {
+        seen_++;
+        if(sample_.size() < capacity_) {
+            sample_.push_back(std::move(element));
+            if(sample_.size() == capacity_) {
+                start_skipping();
+            }
+        } else if(skip_ > 0) {
+            skip_--;
+        } else {
+            keep(std::move(element));
+        }
+    }
+
+    // Adds everything left in source, stepping over the elements that will
+    // not be kept with advance_by.
+    template<typename Source>
+    void add_all(Source& source) {
+        while(sample_.size() < capacity_) {
+            if(!source->advance()) {
+                return;
+            }
+            add(std::move(source->value()));
+        }
+        if(capacity_ == 0) {
+            seen_ += source->advance_by(std::numeric_limits<size_t>::max());
+            return;
+        }
+        while(true) {
+            size_t wanted = skip_ + 1;
+            size_t advanced = source->advance_by(wanted);
+            seen_ += advanced;
+            if(advanced < wanted) {
+                skip_ -= advanced;
+                return;
+            }
+            keep(std::move(source->value()));
+        }
+    }
+
+    // Takes in a reservoir over other elements of the same stream. Each
+    // element of the merged sample comes from this reservoir or the other
+    // with odds in proportion to how many of the elements not yet chosen
+    // each has seen, which keeps every element of both equally likely.
+    void merge(Reservoir&& other) {
+        size_t size = std::min(capacity_, seen_ + other.seen_);
+        std::shuffle(sample_.begin(), sample_.end(), engine_);
+        std::shuffle(other.sample_.begin(), other.sample_.end(), engine_);
+        std::vector<T> merged;
+        merged.reserve(size);
+        size_t left = seen_, right = other.seen_;
+        size_t from_left = 0, from_right = 0;
+        while(merged.size() < size) {
+            std::uniform_int_distribution<size_t> pick(0, left + right - 1);
+            if(pick(engine_) < left) {
+                merged.push_back(std::move(sample_[from_left++]));
+                left--;
+            } else {
+                merged.push_back(std::move(other.sample_[from_right++]));
+                right--;
+            }
+        }
+        sample_.swap(merged);
+        seen_ += other.seen_;
+        if(sample_.size() == capacity_ && capacity_ > 0) {
+            resume_skipping();
+        }
+    }
+
+    size_t seen() const {
+        return seen_;
+    }
+
+    std::vector<T>& sample() {
+        return sample_;
+    }
+
+private:
+    size_t capacity_;
+    Engine engine_;
+    std::vector<T> sample_;
+    size_t seen_ = 0;
+    // The largest of the capacity smallest random keys given to the
+    // elements so far, whose smallest keys are the ones kept.
+    double threshold_ = 1.0;
+    size_t skip_ = 0;
+
+    // Uniform on the open interval (0, 1).
+    double uniform() {
+        std::uniform_real_distribution<double> distribution(
+            std::numeric_limits<double>::min(), 1.0);
+        return distribution(engine_);
+    }
+
+    void start_skipping() {
+        threshold_ = std::exp(std::log(uniform()) / capacity_);
+        next_skip();
+    }
+
+    // After a merge the threshold is redrawn from its distribution given
+    // how many elements have been seen: the capacity-th smallest of that
+    // many uniform keys.
+    void resume_skipping() {
+        std::gamma_distribution<double> kept(static_cast<double>(capacity_));
+        std::gamma_distribution<double> rest(static_cast<double>(seen_ - capacity_ + 1));
+        double a = kept(engine_), b = rest(engine_);
+        threshold_ = a / (a + b);
+        next_skip();
+    }
+
+    void keep(T&& element) {
+        std::uniform_int_distribution<size_t> slot(0, capacity_ - 1);
+        sample_[slot(engine_)] = std::move(element);
+        threshold_ *= std::exp(std::log(uniform()) / capacity_);
+        next_skip();
+    }
+
+    void next_skip() {
+        double skip = std::floor(std::log(uniform()) / std::log1p(-threshold_));
+        double limit = static_cast<double>(std::numeric_limits<size_t>::max() / 2);
+        skip_ = skip < limit ? static_cast<size_t>(skip) : static_cast<size_t>(limit);
+    }
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
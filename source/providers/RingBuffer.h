@@ -0,0 +1,100 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_RING_BUFFER_H
+#define SCHEINERMAN_STREAM_PROVIDERS_RING_BUFFER_H
+
+#include "Slot.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace stream {
+namespace provider {
+
+// A bounded lock-free queue for exactly one producer thread and one
+// consumer thread. Each side owns one index and only reads the other's.
+template<typename T>
+class RingBuffer {
+
+public:
+    explicit RingBuffer(size_t capacity)
+        : slots_(capacity == 0 ? 1 : capacity) {}
+
+    RingBuffer(const RingBuffer<T>&) = delete;
+    RingBuffer<T>& operator= (const RingBuffer<T>&) = delete;
+
+    // Producer side. Returns false, leaving value alone, when full.
+    template<typename U>
+    bool try_push(U&& value) {
+        size_t tail = tail_.index.load(std::memory_order_relaxed);
+        if(tail - head_.index.load(std::memory_order_acquire) == slots_.size()) {
+            return false;
+        }
+        slots_[tail % slots_.size()].emplace(std::forward<U>(value));
+        tail_.index.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Moves the oldest element into out, or returns false
+    // when empty.
+    bool try_pop(Slot<T>& out) {
+        size_t head = head_.index.load(std::memory_order_relaxed);
+        if(head == tail_.index.load(std::memory_order_acquire)) {
+            return false;
+        }
+        Slot<T>& slot = slots_[head % slots_.size()];
+        out.emplace(std::move(*slot));
+        slot.reset();
+        head_.index.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const {
+        return slots_.size();
+    }
+
+private:
+    // Padded out so that each index has a cache line to itself. Padding
+    // rather than alignas, since new only honors extended alignment from
+    // C++17 on.
+    struct PaddedIndex {
+        char before[64];
+        std::atomic<size_t> index{0};
+        char after[64 - sizeof(std::atomic<size_t>)];
+    };
+
+    std::vector<Slot<T>> slots_;
+    PaddedIndex head_;
+    PaddedIndex tail_;
+
+};
+
+// Waits a little longer on each call while a ring buffer stays full or
+// empty: a few busy spins, then yields, then short sleeps.
+class Backoff {
+
+public:
+    void wait() {
+        if(attempts_ < 16) {
+            attempts_++;
+        } else if(attempts_ < 64) {
+            attempts_++;
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+    void reset() {
+        attempts_ = 0;
+    }
+
+private:
+    size_t attempts_ = 0;
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
@@ -17,6 +17,10 @@ public:
             source1_(std::move(source1)),
             source2_(std::move(source2)) {}
 
+    T& value() override {
+        return *result_;
+    }
+
     std::shared_ptr<T> get() override {
         return result_;
     }
@@ -26,7 +30,11 @@ public:
             return false;
         }
 
-        return perform_update();
+        // A stop in either source ends the operation after this element.
+        size_t stops = stream::detail::stops_taken();
+        bool updated = perform_update();
+        stream::detail::relay_stop(stops);
+        return updated;
     }
 
     PrintInfo print(std::ostream& os, int indent) const override {
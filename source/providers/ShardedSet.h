@@ -0,0 +1,170 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_SHARDED_SET_H
+#define SCHEINERMAN_STREAM_PROVIDERS_SHARDED_SET_H
+
+#include "StreamProvider.h"
+
+#include "../StreamExecutor.h"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace stream {
+namespace provider {
+
+// Builds a hash set of a stream's elements on an executor, split into
+// shards by hash. First every worker pulls batches from the source, taking
+// turns, and sorts the elements into buckets of its own, one per shard.
+// Then each shard is put together from the workers' buckets by one task,
+// dropping duplicates when unique is set. Elements of a shard keep the
+// order in which they were bucketed.
+template<typename T, typename Hash, typename Equal>
+class ShardedSet {
+
+public:
+    ShardedSet(const Hash& hash, const Equal& equal, exec::Executor& executor)
+        : hash_(hash), equal_(equal), executor_(executor) {}
+
+    template<typename Source>
+    void build(Source& source, bool unique) {
+        size_t workers = executor_.concurrency();
+        size_t shard_count = workers == 1 ? 1 : workers * 4;
+        std::vector<std::vector<Bucket>> buckets(
+            workers, std::vector<Bucket>(shard_count));
+
+        std::mutex mutex;
+        bool exhausted = false;
+        auto distribute = [&](std::vector<Bucket>& own) {
+            Hash hash = hash_;
+            std::vector<T> batch;
+            batch.reserve(batch_size);
+            while(true) {
+                batch.clear();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if(exhausted) {
+                        return;
+                    }
+                    exhausted = source->advance_batch(batch, batch_size) < batch_size;
+                }
+                for(auto&& element : batch) {
+                    size_t code = hash(element);
+                    own[code % shard_count].emplace_back(code, std::move(element));
+                }
+            }
+        };
+        {
+            exec::TaskGroup group(executor_);
+            for(size_t i = 1; i < workers; i++) {
+                group.run([&distribute, &buckets, i] { distribute(buckets[i]); });
+            }
+            try {
+                distribute(buckets[0]);
+            } catch(...) {
+                // Let the other workers finish before unwinding.
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    exhausted = true;
+                }
+                group.wait();
+                throw;
+            }
+            group.wait();
+        }
+
+        shards_.clear();
+        shards_.resize(shard_count);
+        exec::TaskGroup group(executor_);
+        for(size_t shard = 0; shard < shard_count; shard++) {
+            group.run([this, &buckets, shard, unique] {
+                collect(buckets, shard, unique);
+            });
+        }
+        group.wait();
+    }
+
+    std::vector<std::vector<T>>& shards() {
+        return shards_;
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for(auto& shard : shards_) {
+            total += shard.size();
+        }
+        return total;
+    }
+
+private:
+    using Bucket = std::vector<std::pair<size_t, T>>;
+
+    Hash hash_;
+    Equal equal_;
+    exec::Executor& executor_;
+    std::vector<std::vector<T>> shards_;
+
+    // Looks up entries by index so duplicates can be found without moving
+    // or copying the elements, reusing the hash computed while bucketing.
+    struct IndexHash {
+        const Bucket* entries;
+        size_t operator() (size_t index) const {
+            return (*entries)[index].first;
+        }
+    };
+
+    struct IndexEqual {
+        const Bucket* entries;
+        Equal* equal;
+        bool operator() (size_t left, size_t right) const {
+            const auto& a = (*entries)[left];
+            const auto& b = (*entries)[right];
+            return a.first == b.first && (*equal)(a.second, b.second);
+        }
+    };
+
+    void collect(std::vector<std::vector<Bucket>>& buckets, size_t shard,
+                 bool unique) {
+        Bucket entries;
+        size_t total = 0;
+        for(auto& own : buckets) {
+            total += own[shard].size();
+        }
+        entries.reserve(total);
+        for(auto& own : buckets) {
+            std::move(own[shard].begin(), own[shard].end(),
+                      std::back_inserter(entries));
+            Bucket().swap(own[shard]);
+        }
+
+        std::vector<T>& out = shards_[shard];
+        out.reserve(total);
+        if(!unique) {
+            for(auto& entry : entries) {
+                out.push_back(std::move(entry.second));
+            }
+            return;
+        }
+        Equal equal = equal_;
+        std::unordered_set<size_t, IndexHash, IndexEqual> seen(
+            total, IndexHash{&entries}, IndexEqual{&entries, &equal});
+        std::vector<size_t> kept;
+        for(size_t i = 0; i < entries.size(); i++) {
+            if(seen.insert(i).second) {
+                kept.push_back(i);
+            }
+        }
+        // Only once the lookups are over can the elements be moved out.
+        for(size_t i : kept) {
+            out.push_back(std::move(entries[i].second));
+        }
+    }
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
@@ -15,12 +15,16 @@ template<typename T>
 class Singleton : public StreamProvider<T> {
 
 public:
-    Singleton(const T& value) : value_(std::make_shared<T>(value)) {}
+    Singleton(const T& value) {
+        value_.emplace(value);
+    }
 
-    Singleton(T&& value) : value_(std::make_shared<T>(value)) {}
+    Singleton(T&& value) {
+        value_.emplace(std::move(value));
+    }
 
-    std::shared_ptr<T> get() override {
-        return value_;
+    T& value() override {
+        return *value_;
     }
 
     bool advance_impl() override {
@@ -32,6 +36,14 @@ public:
         return false;
     }
 
+    size_t size_hint() const override {
+        return first_ ? 1 : 0;
+    }
+
+    bool exact_size() const override {
+        return true;
+    }
+
     PrintInfo print(std::ostream& os, int indent) const override {
         this->print_indent(os, indent);
         os << "[singleton stream]\n";
@@ -40,7 +52,7 @@ public:
 
 private:
     bool first_ = true;
-    std::shared_ptr<T> value_;
+    Slot<T> value_;
 };
 
 } /* namespace provider */
@@ -3,54 +3,92 @@
 
 #include "StreamProvider.h"
 
+#include <algorithm>
+
 namespace stream {
 namespace provider {
 
-template<typename T>
+template<typename T, typename Source = StreamProviderPtr<T>>
 class Slice : public StreamProvider<T> {
 
 public:
-    Slice(StreamProviderPtr<T> source, size_t start, size_t end, size_t increment, bool no_end_)
+    Slice(Source source, size_t start, size_t end, size_t increment, bool no_end_)
         : source_(std::move(source)),
           start_(start),
           end_(end),
           increment_(increment),
           no_end_(no_end_) {}
 
+    T& value() override {
+        return source_->value();
+    }
+
     std::shared_ptr<T> get() override {
-        return current_;
+        return source_->get();
     }
 
     bool advance_impl() override {
-        if(index_ < start_) {
-            for(; index_ <= start_; index_++) {
-                if(source_->advance()) {
-                    current_ = source_->get();
-                } else {
-                    current_.reset();
-                    return false;
-                }
+        if(first_) {
+            first_ = false;
+            if(!no_end_ && start_ >= end_) {
+                return false;
             }
-            return true;
+            size_t wanted = start_ + 1 - index_;
+            index_ = start_ + 1;
+            return source_->advance_by(wanted) == wanted;
         }
 
         if(no_end_ || index_ + increment_ <= end_) {
-            for(size_t k = 0; k < increment_; k++) {
-                index_++;
-                if(source_->advance()) {
-                    current_ = source_->get();
-                } else {
-                    current_.reset();
-                    return false;
-                }
-            }
-            return true;
+            index_ += increment_;
+            return source_->advance_by(increment_) == increment_;
         }
 
-        current_.reset();
         return false;
     }
 
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        if(increment_ != 1) {
+            return StreamProvider<T>::advance_batch_impl(batch, n);
+        }
+        size_t count = 0;
+        if(first_) {
+            if(n == 0 || !advance_impl()) {
+                return 0;
+            }
+            batch.push_back(std::move(source_->value()));
+            count++;
+        }
+        size_t wanted = n - count;
+        if(!no_end_) {
+            wanted = std::min(wanted, end_ > index_ ? end_ - index_ : 0);
+        }
+        size_t pulled = source_->advance_batch(batch, wanted);
+        index_ += pulled;
+        return count + pulled;
+    }
+
+    size_t size_hint() const override {
+        size_t available = source_->size_hint();
+        if(available == 0 && !source_->exact_size()) {
+            return 0;
+        }
+        // Positions are counted from the start of the source. The slice
+        // yields start_, start_ + increment_, ... below the limit.
+        size_t limit = index_ + available;
+        if(!no_end_) {
+            limit = std::min(limit, end_);
+        }
+        if(first_) {
+            return limit > start_ ? (limit - start_ - 1) / increment_ + 1 : 0;
+        }
+        size_t position = index_ - 1;
+        return limit > position ? (limit - position - 1) / increment_ : 0;
+    }
+
+    bool exact_size() const override {
+        return source_->exact_size();
+    }
+
     PrintInfo print(std::ostream& os, int indent) const override {
         this->print_indent(os, indent);
         os << "Slice[" << start_ << ", "
@@ -61,8 +99,7 @@ public:
 
 private:
     bool first_ = true;
-    StreamProviderPtr<T> source_;
-    std::shared_ptr<T> current_;
+    Source source_;
     size_t index_ = 0;
     size_t start_;
     size_t end_;
@@ -0,0 +1,93 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_SLOT_H
+#define SCHEINERMAN_STREAM_PROVIDERS_SLOT_H
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace stream {
+namespace provider {
+
+template<typename T>
+class Slot {
+
+public:
+    Slot() = default;
+
+    Slot(const Slot<T>& other) {
+        if(other.occupied_) {
+            emplace(*other);
+        }
+    }
+
+    Slot(Slot<T>&& other) {
+        if(other.occupied_) {
+            emplace(std::move(*other));
+        }
+    }
+
+    ~Slot() {
+        reset();
+    }
+
+    Slot<T>& operator= (const Slot<T>& other) {
+        if(this != &other) {
+            reset();
+            if(other.occupied_) {
+                emplace(*other);
+            }
+        }
+        return *this;
+    }
+
+    Slot<T>& operator= (Slot<T>&& other) {
+        if(this != &other) {
+            reset();
+            if(other.occupied_) {
+                emplace(std::move(*other));
+            }
+        }
+        return *this;
+    }
+
+    template<typename... Args>
+    T& emplace(Args&&... args) {
+        reset();
+        new (&storage_) T(std::forward<Args>(args)...);
+        occupied_ = true;
+        return **this;
+    }
+
+    void reset() {
+        if(occupied_) {
+            occupied_ = false;
+            (**this).~T();
+        }
+    }
+
+    bool occupied() const {
+        return occupied_;
+    }
+
+    T& operator* () {
+        return *reinterpret_cast<T*>(&storage_);
+    }
+
+    const T& operator* () const {
+        return *reinterpret_cast<const T*>(&storage_);
+    }
+
+    T* operator-> () {
+        return &**this;
+    }
+
+private:
+    std::aligned_storage_t<sizeof(T), alignof(T)> storage_;
+    bool occupied_ = false;
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
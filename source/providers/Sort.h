@@ -2,57 +2,279 @@
 #define SCHEINERMAN_STREAM_PROVIDERS_SORT_H
 
 #include "StreamProvider.h"
-#include "../Utility.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
 #include <vector>
-#include <queue>
 
 namespace stream {
 namespace provider {
 
-template<typename T, typename RawCompare>
-class Sort : public StreamProvider<T> {
+namespace detail {
+
+// Numbers compared with std::less can be sorted by their bits instead of by
+// comparisons. Keys are at most 64 bits, which leaves out extended
+// precision long doubles.
+template<typename T, typename Less>
+struct is_radix_sortable : std::integral_constant<bool,
+    std::is_arithmetic<T>::value && !std::is_same<T, bool>::value
+    && sizeof(T) <= sizeof(std::uint64_t)
+    && (std::is_same<std::decay_t<Less>, std::less<void>>::value
+        || std::is_same<std::decay_t<Less>, std::less<T>>::value)> {};
+
+template<size_t Size> struct RadixKeyType;
+template<> struct RadixKeyType<1> { using Type = std::uint8_t; };
+template<> struct RadixKeyType<2> { using Type = std::uint16_t; };
+template<> struct RadixKeyType<4> { using Type = std::uint32_t; };
+template<> struct RadixKeyType<8> { using Type = std::uint64_t; };
+
+// Maps a number to an unsigned key with the same order.
+template<typename T>
+struct RadixKey {
+    using Key = typename RadixKeyType<sizeof(T)>::Type;
+
+    static Key get(T value) {
+        return get(value, std::is_floating_point<T>());
+    }
+
+private:
+    static Key get(T value, std::false_type) {
+        Key key = static_cast<Key>(value);
+        if(std::is_signed<T>::value) {
+            key ^= Key(1) << (sizeof(T) * 8 - 1);
+        }
+        return key;
+    }
+
+    static Key get(T value, std::true_type) {
+        // -0.0 and 0.0 compare equal, so they get the same key.
+        if(value == 0) {
+            value = 0;
+        }
+        Key key;
+        std::memcpy(&key, &value, sizeof(T));
+        Key sign = Key(1) << (sizeof(T) * 8 - 1);
+        return (key & sign) ? ~key : key ^ sign;
+    }
+};
+
+// A least significant digit first radix sort of keys, one byte at a time,
+// skipping the bytes that are the same for every key. Each payload moves
+// along with its key. Stable.
+template<typename Key, typename Payload>
+void radix_sort(std::vector<Key>& keys, std::vector<Payload>& payloads) {
+    std::vector<Key> key_buffer(keys.size());
+    std::vector<Payload> buffer(payloads.size());
+    for(size_t shift = 0; shift < sizeof(Key) * 8; shift += 8) {
+        size_t counts[256] = {};
+        for(Key key : keys) {
+            counts[(key >> shift) & 0xFF]++;
+        }
+        if(counts[(keys[0] >> shift) & 0xFF] == keys.size()) {
+            continue;
+        }
+        size_t offset = 0;
+        for(size_t& count : counts) {
+            size_t next = offset + count;
+            count = offset;
+            offset = next;
+        }
+        for(size_t i = 0; i < keys.size(); i++) {
+            size_t target = counts[(keys[i] >> shift) & 0xFF]++;
+            buffer[target] = payloads[i];
+            key_buffer[target] = keys[i];
+        }
+        payloads.swap(buffer);
+        keys.swap(key_buffer);
+    }
+}
+
+template<typename T>
+void radix_sort(std::vector<T>& values) {
+    std::vector<typename RadixKey<T>::Key> keys(values.size());
+    for(size_t i = 0; i < values.size(); i++) {
+        keys[i] = RadixKey<T>::get(values[i]);
+    }
+    radix_sort(keys, values);
+}
+
+// Below this many elements comparison sorts beat counting passes.
+constexpr size_t radix_threshold = 256;
+
+template<typename T, typename Less>
+void sort_values(std::vector<T>& values, Less& less, bool stable, std::true_type) {
+    if(values.size() >= radix_threshold) {
+        radix_sort(values);
+    } else if(stable) {
+        std::stable_sort(values.begin(), values.end(), less);
+    } else {
+        std::sort(values.begin(), values.end(), less);
+    }
+}
+
+template<typename T, typename Less>
+void sort_values(std::vector<T>& values, Less& less, bool stable, std::false_type) {
+    if(stable) {
+        std::stable_sort(values.begin(), values.end(), less);
+    } else {
+        std::sort(values.begin(), values.end(), less);
+    }
+}
+
+// Sorts values in place, by radix for numbers under std::less and by
+// introsort, or merge sort when stable, for everything else.
+template<typename T, typename Less>
+void sort_values(std::vector<T>& values, Less& less, bool stable) {
+    sort_values(values, less, stable, is_radix_sortable<T, Less>());
+}
+
+} /* namespace detail */
+
+// The part of a sort that stages after it can see without knowing its
+// comparator.
+template<typename T>
+class SortBase : public StreamProvider<T> {
 
 public:
-    Sort(StreamProviderPtr<T> source, RawCompare&& comparator)
-        : source_(std::move(source)), sorted_(PointerCompare(std::forward<RawCompare>(comparator))) {}
+    // Tells the sort that only its first count elements will be read, so it
+    // need not hold on to any others. Has no effect once sorting started.
+    virtual void keep_first(size_t count) = 0;
 
-    std::shared_ptr<T> get() override {
-        return current_;
+};
+
+// Collects the source into one vector on the first advance, sorts it, and
+// then hands the elements out from it. When only the first k elements are
+// wanted, it holds about 2k at a time instead: each time its buffer fills
+// up, it is cut back to the k smallest.
+template<typename T, typename Less, bool Stable = false>
+class Sort : public SortBase<T> {
+
+public:
+    Sort(StreamProviderPtr<T> source, Less&& less)
+        : source_(std::move(source)), less_(less) {}
+
+    Sort(StreamProviderPtr<T> source, Less&& less, size_t count)
+        : source_(std::move(source)), less_(less), bound_(count), bounded_(true) {}
+
+    void keep_first(size_t count) override {
+        if(first_ && (!bounded_ || count < bound_)) {
+            bound_ = count;
+            bounded_ = true;
+        }
+    }
+
+    T& value() override {
+        return sorted_[position_ - 1];
     }
 
     bool advance_impl() override {
-        if(first_) {
-            while(source_->advance()) {
-                sorted_.push(source_->get());
-            }
-            first_ = false;
-        }
-        if(sorted_.empty()) {
-            current_.reset();
+        sort();
+        if(position_ == sorted_.size()) {
             return false;
         }
-        current_ = sorted_.top();
-        sorted_.pop();
+        position_++;
         return true;
     }
 
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        sort();
+        size_t count = std::min(n, sorted_.size() - position_);
+        auto begin = sorted_.begin() + position_;
+        batch.insert(batch.end(), std::make_move_iterator(begin),
+                     std::make_move_iterator(begin + count));
+        position_ += count;
+        return count;
+    }
+
+    size_t advance_by_impl(size_t n) override {
+        sort();
+        size_t count = std::min(n, sorted_.size() - position_);
+        position_ += count;
+        return count;
+    }
+
+    size_t size_hint() const override {
+        if(!first_) {
+            return sorted_.size() - position_;
+        }
+        size_t available = source_->size_hint();
+        return bounded_ ? std::min(available, bound_) : available;
+    }
+
+    bool exact_size() const override {
+        return !first_ || source_->exact_size();
+    }
+
     PrintInfo print(std::ostream& os, int indent) const override {
         this->print_indent(os, indent);
-        os << "Sort:\n";
+        os << (Stable ? "StableSort" : "Sort");
+        if(bounded_) {
+            os << " (first " << bound_ << ")";
+        }
+        os << ":\n";
         return source_->print(os, indent + 1).addStage();
     }
 
 private:
-    using PointerCompare = ComparePtrWrapper<T, RawCompare, true>;
-    using PointerQueue = std::priority_queue<std::shared_ptr<T>,
-                                             std::vector<std::shared_ptr<T>>,
-                                             PointerCompare>;
-
     StreamProviderPtr<T> source_;
-    PointerQueue sorted_;
-    std::shared_ptr<T> current_;
+    Less less_;
+    std::vector<T> sorted_;
+    size_t position_ = 0;
+    size_t bound_ = 0;
+    bool bounded_ = false;
     bool first_ = true;
+
+    void sort() {
+        if(!first_) {
+            return;
+        }
+        first_ = false;
+        if(bounded_ && bound_ < std::numeric_limits<size_t>::max() / 4) {
+            sort_first();
+            return;
+        }
+        sorted_.reserve(source_->size_hint());
+        while(source_->advance_batch(sorted_, batch_size) == batch_size) {}
+        detail::sort_values(sorted_, less_, Stable);
+    }
+
+    void sort_first() {
+        if(bound_ == 0) {
+            return;
+        }
+        // Each cut keeps bound_ elements and makes room for bound_ more.
+        size_t capacity = 2 * bound_;
+        bool exhausted = false;
+        while(!exhausted) {
+            size_t wanted = std::min<size_t>(capacity - sorted_.size(), batch_size);
+            exhausted = source_->advance_batch(sorted_, wanted) < wanted;
+            if(sorted_.size() == capacity) {
+                cut();
+            }
+        }
+        if(sorted_.size() > bound_) {
+            cut();
+        }
+        detail::sort_values(sorted_, less_, Stable);
+    }
+
+    // Drops all but the bound_ smallest elements. A stable sort keeps
+    // the earlier of equal elements, which arrived first.
+    void cut() {
+        if(Stable) {
+            std::stable_sort(sorted_.begin(), sorted_.end(), less_);
+        } else {
+            std::nth_element(sorted_.begin(), sorted_.begin() + bound_,
+                             sorted_.end(), less_);
+        }
+        sorted_.erase(sorted_.begin() + bound_, sorted_.end());
+    }
+
 };
 
 } /* namespace provider */
@@ -0,0 +1,145 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_SORT_BY_H
+#define SCHEINERMAN_STREAM_PROVIDERS_SORT_BY_H
+
+#include "StreamProvider.h"
+#include "Sort.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stream {
+namespace provider {
+
+// Sorts the source by a key computed once per element rather than once per
+// comparison: elements are collected next to their keys, sorted by key and
+// handed out without them. Numeric keys under std::less are radix sorted.
+// Elements with equal keys stay in stream order, and with Unique set only
+// the first of them is kept.
+template<typename T, typename KeyFn, typename Less, bool Unique>
+class SortBy : public StreamProvider<T> {
+
+public:
+    using Key = std::decay_t<std::result_of_t<KeyFn&(T&)>>;
+
+    SortBy(StreamProviderPtr<T> source, KeyFn&& key_fn, Less&& less)
+        : source_(std::move(source)), key_fn_(key_fn), less_(less) {}
+
+    T& value() override {
+        return sorted_[position_ - 1].second;
+    }
+
+    bool advance_impl() override {
+        sort();
+        if(position_ == sorted_.size()) {
+            return false;
+        }
+        position_++;
+        return true;
+    }
+
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        sort();
+        size_t count = std::min(n, sorted_.size() - position_);
+        batch.reserve(batch.size() + count);
+        for(size_t i = 0; i < count; i++) {
+            batch.push_back(std::move(sorted_[position_++].second));
+        }
+        return count;
+    }
+
+    size_t advance_by_impl(size_t n) override {
+        sort();
+        size_t count = std::min(n, sorted_.size() - position_);
+        position_ += count;
+        return count;
+    }
+
+    size_t size_hint() const override {
+        return first_ ? source_->size_hint() : sorted_.size() - position_;
+    }
+
+    bool exact_size() const override {
+        return !first_;
+    }
+
+    PrintInfo print(std::ostream& os, int indent) const override {
+        this->print_indent(os, indent);
+        os << (Unique ? "DistinctBy:\n" : "SortBy:\n");
+        return source_->print(os, indent + 1).addStage();
+    }
+
+private:
+    using Entry = std::pair<Key, T>;
+
+    StreamProviderPtr<T> source_;
+    KeyFn key_fn_;
+    Less less_;
+    std::vector<Entry> sorted_;
+    size_t position_ = 0;
+    bool first_ = true;
+
+    void sort() {
+        if(!first_) {
+            return;
+        }
+        first_ = false;
+        sorted_.reserve(source_->size_hint());
+        std::vector<T> batch;
+        batch.reserve(batch_size);
+        size_t pulled;
+        do {
+            batch.clear();
+            pulled = source_->advance_batch(batch, batch_size);
+            for(auto&& element : batch) {
+                Key key = key_fn_(element);
+                sorted_.emplace_back(std::move(key), std::move(element));
+            }
+        } while(pulled == batch_size);
+
+        sort_entries(detail::is_radix_sortable<Key, Less>());
+        if(Unique) {
+            auto same = [this](const Entry& left, const Entry& right) {
+                return !less_(left.first, right.first) && !less_(right.first, left.first);
+            };
+            sorted_.erase(std::unique(sorted_.begin(), sorted_.end(), same),
+                          sorted_.end());
+        }
+    }
+
+    void sort_entries(std::true_type) {
+        if(sorted_.size() < detail::radix_threshold) {
+            sort_entries(std::false_type());
+            return;
+        }
+        std::vector<typename detail::RadixKey<Key>::Key> keys(sorted_.size());
+        std::vector<size_t> order(sorted_.size());
+        for(size_t i = 0; i < sorted_.size(); i++) {
+            keys[i] = detail::RadixKey<Key>::get(sorted_[i].first);
+            order[i] = i;
+        }
+        detail::radix_sort(keys, order);
+        std::vector<Entry> reordered;
+        reordered.reserve(sorted_.size());
+        for(size_t index : order) {
+            reordered.push_back(std::move(sorted_[index]));
+        }
+        sorted_.swap(reordered);
+    }
+
+    // Stable, so that the first of the elements with the same key is the
+    // one a distinct keeps.
+    void sort_entries(std::false_type) {
+        std::stable_sort(sorted_.begin(), sorted_.end(),
+            [this](const Entry& left, const Entry& right) {
+                return less_(left.first, right.first);
+            });
+    }
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
@@ -16,6 +16,10 @@ public:
     Stateful(StreamProviderPtr<T> source)
         : source_(std::move(source)) {}
 
+    T& value() override {
+        return **current_;
+    }
+
     std::shared_ptr<T> get() override {
         return *current_;
     }
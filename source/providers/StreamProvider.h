@@ -2,12 +2,18 @@
 #define SCHEINERMAN_STREAM_PROVIDER_H
 
 #include "../StreamError.h"
+#include "Slot.h"
 
 #include <memory>
+#include <vector>
 
 namespace stream {
 namespace provider {
 
+// How many elements terminators and parallel stages pull from a source at a
+// time with advance_batch.
+constexpr size_t batch_size = 1024;
+
 struct PrintInfo {
     PrintInfo(int sources_, int stages_)
         : sources(sources_), stages(stages_) {}
@@ -28,22 +34,99 @@ struct PrintInfo {
     int stages;
 };
 
+template<typename P> class Inline;
+
 template<typename T>
 struct StreamProvider {
 
 public:
     struct Iterator;
 
-    virtual std::shared_ptr<T> get() = 0;
+    using element_type = T;
+
+    virtual ~StreamProvider() = default;
+
+    // Returns the current element, which stays valid until the next call to
+    // advance(). Callers are free to move out of it. Unlike get(), this never
+    // allocates, so stages should prefer it when pulling from their sources.
+    virtual T& value() = 0;
 
+    virtual std::shared_ptr<T> get() {
+        return std::make_shared<T>(std::move(value()));
+    }
+
+    // Returns false once the stream is exhausted, and keeps returning false
+    // after that. The element during which a stop was requested is still
+    // produced; the stream ends after it. A StopStream thrown while producing
+    // the next element ends the stream in its place and is taken like a
+    // request, so stages above can tell. The handler sits around
+    // the whole call, so it costs nothing unless something throws.
     bool advance() {
-        try {
-            return advance_impl();
-        } catch(stream::StopStream& stop) {
+        if(stopped_) {
             return false;
-        } catch(...) {
-            throw;
         }
+        bool advanced;
+        try {
+            advanced = advance_impl();
+        } catch(stream::StopStream&) {
+            advanced = false;
+            stream::detail::stop_flag() = true;
+        }
+        stopped_ = stream::detail::take_stop_request() || !advanced;
+        return advanced;
+    }
+
+    // Advances up to n times, appending the elements passed over to batch,
+    // and returns how many were appended. Fewer than n are appended only once
+    // the stream has ended. Afterwards there is no current element, but
+    // advance() carries on from the element after the batch.
+    size_t advance_batch(std::vector<T>& batch, size_t n) {
+        if(stopped_) {
+            return 0;
+        }
+        size_t start = batch.size();
+        size_t count;
+        try {
+            count = advance_batch_impl(batch, n);
+        } catch(stream::StopStream&) {
+            count = batch.size() - start;
+            stream::detail::stop_flag() = true;
+        }
+        stopped_ = stream::detail::take_stop_request() || count < n;
+        return count;
+    }
+
+    // Advances n times, or until the stream ends, and returns how many times
+    // it advanced. The current element is then the one the last advance()
+    // would have produced. Sources that can seek skip the elements in
+    // between without producing them.
+    size_t advance_by(size_t n) {
+        if(stopped_) {
+            return 0;
+        }
+        size_t count = advance_by_impl(n);
+        stopped_ = stream::detail::take_stop_request() || count < n;
+        return count;
+    }
+
+    // Hands the first part of the elements still to come to a new provider
+    // and keeps the rest, so the two can be drained independently, e.g. on
+    // different threads. Stages that pass through splits copy their
+    // functions, so they should not rely on shared state. Must be called
+    // before the first advance(). Returns nullptr if the provider cannot
+    // split.
+    virtual std::unique_ptr<StreamProvider<T>> try_split() {
+        return nullptr;
+    }
+
+    // Returns how many more elements advance() is expected to produce, or 0
+    // if nothing is known. When exact_size() is true the count is exact.
+    virtual size_t size_hint() const {
+        return 0;
+    }
+
+    virtual bool exact_size() const {
+        return false;
     }
 
     Iterator begin();
@@ -54,6 +137,31 @@ public:
 protected:
     virtual bool advance_impl() = 0;
 
+    // Stages that call user functions while filling a batch must stop after
+    // the element during which a stop was requested. If one of them throws
+    // StopStream, batch must be left holding only elements to pass on.
+    virtual size_t advance_batch_impl(std::vector<T>& batch, size_t n) {
+        size_t count = 0;
+        while(count < n && advance()) {
+            batch.push_back(std::move(value()));
+            count++;
+        }
+        return count;
+    }
+
+    virtual size_t advance_by_impl(size_t n) {
+        size_t count = 0;
+        while(count < n && advance()) {
+            count++;
+        }
+        return count;
+    }
+
+private:
+    template<typename> friend class Inline;
+
+    bool stopped_ = false;
+
 protected:
     static void print_indent(std::ostream& os, int indent) {
         for(int i = 0; i < indent - 1; i++) {
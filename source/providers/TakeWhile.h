@@ -6,27 +6,25 @@
 namespace stream {
 namespace provider {
 
-template<typename T, typename Predicate>
+template<typename T, typename Predicate, typename Source = StreamProviderPtr<T>>
 class TakeWhile : public StreamProvider<T> {
 
 public:
-    TakeWhile(StreamProviderPtr<T> source, Predicate&& predicate)
+    TakeWhile(Source source, Predicate&& predicate)
         : source_(std::move(source)), predicate_(predicate) {}
 
+    T& value() override {
+        return source_->value();
+    }
+
     std::shared_ptr<T> get() override {
-        return current_;
+        return source_->get();
     }
 
     bool advance_impl() override {
         if(source_->advance()) {
-            current_ = source_->get();
-            if(!predicate_(*current_)) {
-                current_.reset();
-                return false;
-            }
-            return true;
+            return predicate_(source_->value());
         }
-        current_.reset();
         return false;
     }
 
@@ -37,9 +35,8 @@ public:
     }
 
 private:
-    StreamProviderPtr<T> source_;
+    Source source_;
     Predicate predicate_;
-    std::shared_ptr<T> current_;
 };
 
 } /* namespace provider */
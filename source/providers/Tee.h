@@ -0,0 +1,221 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_TEE_H
+#define SCHEINERMAN_STREAM_PROVIDERS_TEE_H
+
+#include "StreamProvider.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace stream {
+namespace provider {
+
+// The part of a source that some, but not all, branches of a tee have read.
+// Whichever branch is furthest ahead pulls from the source, and elements are
+// dropped once the slowest branch has read them. Safe to use from one
+// thread per branch. With a capacity, a branch that would grow the buffer
+// past it waits for the others to catch up, so then every branch must be
+// read on its own thread.
+template<typename T>
+class TeeBuffer {
+
+public:
+    TeeBuffer(StreamProviderPtr<T> source, size_t branches, size_t capacity)
+        : source_(std::move(source)), positions_(branches, 0), capacity_(capacity) {}
+
+    // Appends up to n elements for the branch to batch, moving those that no
+    // other branch still needs. Returns fewer than n only at the end.
+    size_t read(size_t branch, std::vector<T>& batch, size_t n) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        size_t count = 0;
+        while(count < n) {
+            size_t& position = positions_[branch];
+            if(position == end()) {
+                if(!fill(branch, lock)) {
+                    break;
+                }
+                continue;
+            }
+            size_t available = std::min(n - count, end() - position);
+            // Elements every other branch is already past can be moved.
+            size_t movable = std::max(position, std::min(others(branch), position + available));
+            for(size_t i = position; i < position + available; i++) {
+                if(i < movable) {
+                    batch.push_back(std::move(buffer_[i - base_]));
+                } else {
+                    batch.push_back(buffer_[i - base_]);
+                }
+            }
+            position += available;
+            count += available;
+            trim();
+        }
+        return count;
+    }
+
+    // Stops holding elements back for a branch that has been destroyed.
+    void leave(size_t branch) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        positions_[branch] = std::numeric_limits<size_t>::max();
+        trim();
+    }
+
+    size_t remaining(size_t branch) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return source_->size_hint() + end() - positions_[branch];
+    }
+
+    bool exact_size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return source_->exact_size();
+    }
+
+    PrintInfo print(std::ostream& os, int indent) const {
+        return source_->print(os, indent);
+    }
+
+private:
+    static constexpr size_t pull_size = 256;
+
+    StreamProviderPtr<T> source_;
+    std::deque<T> buffer_;
+    // Index in the stream of the first element in buffer_.
+    size_t base_ = 0;
+    std::vector<size_t> positions_;
+    size_t capacity_;
+    bool exhausted_ = false;
+    std::exception_ptr error_;
+    mutable std::mutex mutex_;
+    std::condition_variable trimmed_;
+    std::vector<T> pulled_;
+
+    size_t end() const {
+        return base_ + buffer_.size();
+    }
+
+    // The position of the slowest branch other than this one.
+    size_t others(size_t branch) const {
+        size_t slowest = std::numeric_limits<size_t>::max();
+        for(size_t i = 0; i < positions_.size(); i++) {
+            if(i != branch) {
+                slowest = std::min(slowest, positions_[i]);
+            }
+        }
+        return slowest;
+    }
+
+    void trim() {
+        size_t slowest = *std::min_element(positions_.begin(), positions_.end());
+        bool dropped = false;
+        while(base_ < slowest && !buffer_.empty()) {
+            buffer_.pop_front();
+            base_++;
+            dropped = true;
+        }
+        if(dropped) {
+            trimmed_.notify_all();
+        }
+    }
+
+    // Pulls more of the source into the buffer, unless another branch does
+    // so while this one waits for room. Returns false at the end.
+    bool fill(size_t branch, std::unique_lock<std::mutex>& lock) {
+        if(capacity_ > 0) {
+            trimmed_.wait(lock, [this, branch] {
+                return buffer_.size() < capacity_ || positions_[branch] < end()
+                    || exhausted_ || error_;
+            });
+            if(positions_[branch] < end()) {
+                return true;
+            }
+        }
+        if(error_) {
+            std::rethrow_exception(error_);
+        }
+        if(exhausted_) {
+            return false;
+        }
+        size_t wanted = capacity_ > 0
+            ? std::min(pull_size, capacity_ - buffer_.size())
+            : pull_size;
+        pulled_.clear();
+        try {
+            exhausted_ = source_->advance_batch(pulled_, wanted) < wanted;
+        } catch(...) {
+            error_ = std::current_exception();
+            trimmed_.notify_all();
+            throw;
+        }
+        std::move(pulled_.begin(), pulled_.end(), std::back_inserter(buffer_));
+        trimmed_.notify_all();
+        return !pulled_.empty();
+    }
+
+};
+
+template<typename T>
+constexpr size_t TeeBuffer<T>::pull_size;
+
+// One branch of a tee.
+template<typename T>
+class Tee : public StreamProvider<T> {
+
+public:
+    Tee(std::shared_ptr<TeeBuffer<T>> buffer, size_t branch)
+        : buffer_(std::move(buffer)), branch_(branch) {}
+
+    ~Tee() {
+        buffer_->leave(branch_);
+    }
+
+    T& value() override {
+        return *current_;
+    }
+
+    bool advance_impl() override {
+        next_.clear();
+        if(buffer_->read(branch_, next_, 1) == 0) {
+            current_.reset();
+            return false;
+        }
+        current_.emplace(std::move(next_.front()));
+        return true;
+    }
+
+    size_t advance_batch_impl(std::vector<T>& batch, size_t n) override {
+        current_.reset();
+        return buffer_->read(branch_, batch, n);
+    }
+
+    size_t size_hint() const override {
+        return buffer_->remaining(branch_);
+    }
+
+    bool exact_size() const override {
+        return buffer_->exact_size();
+    }
+
+    PrintInfo print(std::ostream& os, int indent) const override {
+        this->print_indent(os, indent);
+        os << "Tee (branch " << branch_ << "):\n";
+        return buffer_->print(os, indent + 1).addStage();
+    }
+
+private:
+    std::shared_ptr<TeeBuffer<T>> buffer_;
+    size_t branch_;
+    Slot<T> current_;
+    std::vector<T> next_;
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
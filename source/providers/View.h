@@ -0,0 +1,170 @@
+#ifndef SCHEINERMAN_STREAM_PROVIDERS_VIEW_H
+#define SCHEINERMAN_STREAM_PROVIDERS_VIEW_H
+
+#include "StreamProvider.h"
+
+#include "../Utility.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+namespace stream {
+namespace provider {
+
+// Like Iterator, but yields const references to the elements in place
+// instead of moving them out, so the range is left untouched and nothing
+// is copied.
+template<typename T, typename Itr>
+class View : public StreamProvider<std::reference_wrapper<const T>> {
+
+private:
+    using Reference = std::reference_wrapper<const T>;
+
+public:
+    View(Itr begin, Itr end)
+        : current_(begin), end_(end) {}
+
+    Reference& value() override {
+        return *value_;
+    }
+
+    bool advance_impl() override {
+        if(first_) {
+            first_ = false;
+        } else if(current_ != end_) {
+            ++current_;
+        }
+        if(current_ == end_) {
+            value_.reset();
+            return false;
+        }
+        value_.emplace(*current_);
+        return true;
+    }
+
+    size_t advance_batch_impl(std::vector<Reference>& batch, size_t n) override {
+        value_.reset();
+        if(n == 0) {
+            return 0;
+        }
+        if(first_) {
+            first_ = false;
+        } else if(current_ != end_) {
+            ++current_;
+        }
+        if(current_ == end_) {
+            return 0;
+        }
+        return take(batch, n, Category{});
+    }
+
+    size_t advance_by_impl(size_t n) override {
+        return seek(n, Category{});
+    }
+
+    StreamProviderPtr<Reference> try_split() override {
+        return split(Category{});
+    }
+
+    size_t size_hint() const override {
+        return remaining(Category{});
+    }
+
+    bool exact_size() const override {
+        return std::is_base_of<std::random_access_iterator_tag, Category>::value;
+    }
+
+    PrintInfo print(std::ostream& os, int indent) const override {
+        this->print_indent(os, indent);
+        os << "[view stream]\n";
+        return PrintInfo::Source();
+    }
+
+private:
+    using Category = typename std::iterator_traits<Itr>::iterator_category;
+
+    // Both overloads leave current_ on the last element taken.
+    size_t take(std::vector<Reference>& batch, size_t n, std::random_access_iterator_tag) {
+        size_t count = std::min<size_t>(n, end_ - current_);
+        batch.insert(batch.end(), current_, current_ + count);
+        current_ += count - 1;
+        return count;
+    }
+
+    size_t take(std::vector<Reference>& batch, size_t n, std::input_iterator_tag) {
+        size_t count = 0;
+        while(true) {
+            batch.push_back(std::cref(*current_));
+            if(++count == n) {
+                return count;
+            }
+            Itr next = current_;
+            if(++next == end_) {
+                return count;
+            }
+            current_ = next;
+        }
+    }
+
+    size_t seek(size_t n, std::random_access_iterator_tag) {
+        if(n == 0) {
+            return 0;
+        }
+        Itr next = current_;
+        if(first_) {
+            first_ = false;
+        } else if(current_ != end_) {
+            ++next;
+        }
+        size_t available = end_ - next;
+        if(n > available) {
+            current_ = end_;
+            value_.reset();
+            return available;
+        }
+        current_ = next + (n - 1);
+        value_.emplace(*current_);
+        return n;
+    }
+
+    size_t seek(size_t n, std::input_iterator_tag) {
+        return StreamProvider<Reference>::advance_by_impl(n);
+    }
+
+    StreamProviderPtr<Reference> split(std::random_access_iterator_tag) {
+        if(!first_ || end_ - current_ < 2) {
+            return nullptr;
+        }
+        Itr middle = current_ + (end_ - current_) / 2;
+        StreamProviderPtr<Reference> prefix(new View<T, Itr>(current_, middle));
+        current_ = middle;
+        return prefix;
+    }
+
+    StreamProviderPtr<Reference> split(std::input_iterator_tag) {
+        return nullptr;
+    }
+
+    size_t remaining(std::random_access_iterator_tag) const {
+        if(first_) {
+            return end_ - current_;
+        }
+        return current_ == end_ ? 0 : end_ - current_ - 1;
+    }
+
+    size_t remaining(std::input_iterator_tag) const {
+        return 0;
+    }
+
+    bool first_ = true;
+    Itr current_;
+    Itr end_;
+    Slot<Reference> value_;
+
+};
+
+} /* namespace provider */
+} /* namespace stream */
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "StreamProvider.h"
 
+#include <algorithm>
 #include <tuple>
 #include <type_traits>
 
@@ -73,21 +74,38 @@ public:
             right_source_(std::move(right_source)),
             zipper_(zipper) {}
 
-    std::shared_ptr<ValueType> get() override {
-        return current_;
+    ValueType& value() override {
+        return *current_;
     }
 
     bool advance_impl() override {
         if(left_source_->advance() && right_source_->advance()) {
-            current_ = std::make_shared<ValueType>(
-                zipper_(std::move(*left_source_->get()),
-                        std::move(*right_source_->get())));
+            current_.emplace(zipper_(std::move(left_source_->value()),
+                                     std::move(right_source_->value())));
             return true;
         }
         current_.reset();
         return false;
     }
 
+    size_t size_hint() const override {
+        size_t left = left_source_->size_hint();
+        size_t right = right_source_->size_hint();
+        if(!known(left_source_, left)) {
+            return right;
+        }
+        if(!known(right_source_, right)) {
+            return left;
+        }
+        return std::min(left, right);
+    }
+
+    // Only the default zipper is known not to request a stop.
+    bool exact_size() const override {
+        return std::is_same<Function, detail::Zipper>::value
+            && left_source_->exact_size() && right_source_->exact_size();
+    }
+
     PrintInfo print(std::ostream& os, int indent) const override {
         this->print_indent(os, indent);
         os << "Zip:\n";
@@ -96,9 +114,14 @@ public:
     }
 
 private:
+    template<typename Source>
+    static bool known(const Source& source, size_t hint) {
+        return hint > 0 || source->exact_size();
+    }
+
     StreamProviderPtr<L> left_source_;
     StreamProviderPtr<R> right_source_;
-    std::shared_ptr<ValueType> current_;
+    Slot<ValueType> current_;
     Function zipper_;
 };
 
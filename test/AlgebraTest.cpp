@@ -2,6 +2,8 @@
 
 #include <gmock/gmock.h>
 
+#include <thread>
+
 using namespace testing;
 using namespace stream;
 using namespace stream::op;
@@ -191,3 +193,18 @@ TEST(AlgebraTest, BitShiftRight) {
     EXPECT_THAT((12 >> MakeStream::from({3, 4, 5})) | to_vector(),
                 ElementsAre(12 >> 3, 12 >> 4, 12 >> 5));
 }
+
+TEST(AlgebraTest, AdditionOnSeparateThreads) {
+    std::thread::id left, right;
+    auto result = ((MakeStream::range(0, 100)
+                        | peek([&](int) { left = std::this_thread::get_id(); })
+                        | async_buffer(4))
+                   + (MakeStream::range(0, 100)
+                        | peek([&](int) { right = std::this_thread::get_id(); })
+                        | async_buffer(4)))
+        | to_vector();
+    EXPECT_THAT(result, ElementsAreArray(MakeStream::range(0, 200, 2) | to_vector()));
+    EXPECT_THAT(left, Ne(std::this_thread::get_id()));
+    EXPECT_THAT(right, Ne(std::this_thread::get_id()));
+    EXPECT_THAT(left, Ne(right));
+}
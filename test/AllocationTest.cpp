@@ -0,0 +1,67 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <cstdlib>
+#include <new>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+static size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if(void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+template<typename Pipeline>
+size_t count_allocations(Pipeline&& pipeline) {
+    size_t before = allocations;
+    pipeline();
+    return allocations - before;
+}
+
+TEST(AllocationTest, MapFilterSum) {
+    std::vector<int> small(10, 1);
+    std::vector<int> large(10000, 1);
+
+    auto run = [](const std::vector<int>& input) {
+        return [&input]() {
+            int result = MakeStream::from(input)
+                | map_([](int x) { return x * 2; })
+                | filter([](int x) { return x > 0; })
+                | sum();
+            EXPECT_THAT(result, Eq(2 * input.size()));
+        };
+    };
+
+    EXPECT_THAT(count_allocations(run(large)),
+                Eq(count_allocations(run(small))));
+}
+
+TEST(AllocationTest, ZipCount) {
+    auto run = [](int length) {
+        return [length]() {
+            auto result = MakeStream::counter(0)
+                | zip_with(MakeStream::counter(0), std::plus<int>())
+                | limit(length)
+                | count();
+            EXPECT_THAT(result, Eq(length));
+        };
+    };
+
+    EXPECT_THAT(count_allocations(run(10000)), Eq(count_allocations(run(10))));
+}
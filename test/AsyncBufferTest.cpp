@@ -0,0 +1,93 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+TEST(AsyncBufferTest, RingBuffer) {
+    provider::RingBuffer<std::string> ring(2);
+    provider::Slot<std::string> out;
+    EXPECT_FALSE(ring.try_pop(out));
+    EXPECT_TRUE(ring.try_push("a"));
+    EXPECT_TRUE(ring.try_push("b"));
+    EXPECT_FALSE(ring.try_push("c"));
+    ASSERT_TRUE(ring.try_pop(out));
+    EXPECT_THAT(*out, Eq("a"));
+    EXPECT_TRUE(ring.try_push("c"));
+    ASSERT_TRUE(ring.try_pop(out));
+    EXPECT_THAT(*out, Eq("b"));
+    ASSERT_TRUE(ring.try_pop(out));
+    EXPECT_THAT(*out, Eq("c"));
+    EXPECT_FALSE(ring.try_pop(out));
+}
+
+TEST(AsyncBufferTest, PreservesElements) {
+    auto expected = MakeStream::range(0, 10000) | to_vector();
+    EXPECT_THAT(MakeStream::range(0, 10000) | async_buffer(16) | to_vector(),
+                Eq(expected));
+    EXPECT_THAT(MakeStream::range(0, 10000) | async_buffer(1) | sum(),
+                Eq(49995000));
+    EXPECT_THAT(MakeStream::empty<int>() | async_buffer(8) | to_vector(),
+                IsEmpty());
+
+    std::vector<int> seen;
+    for(int x : MakeStream::from({1, 2, 3}) | async_buffer(4)) {
+        seen.push_back(x);
+    }
+    EXPECT_THAT(seen, ElementsAre(1, 2, 3));
+}
+
+TEST(AsyncBufferTest, RunsUpstreamOnItsOwnThread) {
+    auto consumer = std::this_thread::get_id();
+    auto threads = MakeStream::range(0, 100)
+        | map_([](int) { return std::this_thread::get_id(); })
+        | async_buffer(8)
+        | filter([consumer](std::thread::id id) { return id == consumer; })
+        | count();
+    EXPECT_THAT(threads, Eq(0));
+}
+
+TEST(AsyncBufferTest, Overlaps) {
+    using namespace std::chrono;
+    auto slow = [](int x) {
+        std::this_thread::sleep_for(milliseconds(2));
+        return x;
+    };
+    auto start = steady_clock::now();
+    int total = 0;
+    for(int x : MakeStream::range(0, 40) | map_(slow) | async_buffer(8)) {
+        total += slow(x);
+    }
+    auto elapsed = steady_clock::now() - start;
+    EXPECT_THAT(total, Eq(780));
+    EXPECT_THAT(duration_cast<milliseconds>(elapsed).count(), Lt(140));
+}
+
+TEST(AsyncBufferTest, EarlyExit) {
+    EXPECT_THAT(MakeStream::counter(0) | async_buffer(4) | limit(5) | to_vector(),
+                ElementsAre(0, 1, 2, 3, 4));
+}
+
+TEST(AsyncBufferTest, Exception) {
+    auto stream = MakeStream::range(0, 100)
+        | map_([](int x) {
+            if(x == 50) {
+                throw std::runtime_error("source");
+            }
+            return x;
+        })
+        | async_buffer(8);
+    std::vector<int> seen;
+    auto read = [&] {
+        for(int x : stream) {
+            seen.push_back(x);
+        }
+    };
+    EXPECT_THROW(read(), std::runtime_error);
+}
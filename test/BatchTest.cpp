@@ -0,0 +1,104 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <list>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+template<typename T>
+std::vector<T> batch_of(Stream<T>& stream, size_t n) {
+    std::vector<T> batch;
+    stream.getSource()->advance_batch(batch, n);
+    return batch;
+}
+
+// Vectors copy rather than move elements whose move may throw when they
+// grow, so copies also count reallocations.
+struct Copied {
+    Copied(int value_) : value(value_) {}
+    Copied(const Copied& other) : value(other.value) { copies++; }
+    Copied(Copied&& other) : value(other.value) {}
+    Copied& operator= (const Copied& other) { value = other.value; copies++; return *this; }
+    Copied& operator= (Copied&& other) { value = other.value; return *this; }
+
+    int value;
+    static size_t copies;
+};
+
+size_t Copied::copies = 0;
+
+TEST(BatchTest, Iterator) {
+    std::vector<int> input = {1, 2, 3, 4, 5};
+    auto stream = MakeStream::from(input);
+    EXPECT_THAT(batch_of(stream, 2), ElementsAre(1, 2));
+    EXPECT_THAT(stream.getSource()->advance(), Eq(true));
+    EXPECT_THAT(stream.getSource()->value(), Eq(3));
+    EXPECT_THAT(batch_of(stream, 10), ElementsAre(4, 5));
+    EXPECT_THAT(batch_of(stream, 10), IsEmpty());
+}
+
+TEST(BatchTest, ForwardIterator) {
+    std::list<int> input = {1, 2, 3, 4, 5};
+    auto stream = MakeStream::from(input);
+    EXPECT_THAT(batch_of(stream, 3), ElementsAre(1, 2, 3));
+    EXPECT_THAT(batch_of(stream, 3), ElementsAre(4, 5));
+    EXPECT_THAT(stream.getSource()->advance(), Eq(false));
+}
+
+TEST(BatchTest, Cycle) {
+    auto stream = MakeStream::cycle({1, 2, 3}, 2);
+    EXPECT_THAT(batch_of(stream, 4), ElementsAre(1, 2, 3, 1));
+    EXPECT_THAT(batch_of(stream, 4), ElementsAre(2, 3));
+}
+
+TEST(BatchTest, Stages) {
+    auto stream = MakeStream::counter(0)
+        | filter([](int x) { return x % 3 == 0; })
+        | map_([](int x) { return x * 2; })
+        | skip(1)
+        | limit(5);
+    EXPECT_THAT(batch_of(stream, 3), ElementsAre(6, 12, 18));
+    EXPECT_THAT(batch_of(stream, 3), ElementsAre(24, 30));
+}
+
+TEST(BatchTest, MapAddsNoCopies) {
+    std::list<Copied> input(3000, Copied(1));
+    Copied::copies = 0;
+    MakeStream::from(input) | to_vector();
+    size_t unmapped = Copied::copies;
+    Copied::copies = 0;
+    auto result = MakeStream::from(input)
+        | map_([](Copied&& c) { return std::move(c); })
+        | to_vector();
+    EXPECT_THAT(result.size(), Eq(3000));
+    EXPECT_THAT(Copied::copies, Eq(unmapped));
+}
+
+TEST(BatchTest, Concatenate) {
+    auto stream = MakeStream::from({1, 2}) | concat(MakeStream::from({3, 4, 5}));
+    EXPECT_THAT(batch_of(stream, 3), ElementsAre(1, 2, 3));
+    EXPECT_THAT(batch_of(stream, 3), ElementsAre(4, 5));
+}
+
+TEST(BatchTest, RetainedElements) {
+    EXPECT_THAT(MakeStream::repeat(std::string("a")) | limit(3) | to_vector(),
+                ElementsAre("a", "a", "a"));
+    EXPECT_THAT(MakeStream::from({"a", "b"}) | map_([](auto s) { return std::string(s); })
+                                            | partial_sum()
+                                            | to_vector(),
+                ElementsAre("a", "ab"));
+}
+
+TEST(BatchTest, Terminators) {
+    EXPECT_THAT(MakeStream::range(0, 5000) | count(), Eq(5000));
+    EXPECT_THAT(MakeStream::range(0, 5000) | sum(), Eq(12497500));
+    EXPECT_THAT(MakeStream::range(0, 3000) | filter([](int x) { return x % 2 == 0; })
+                                           | to_vector(),
+                SizeIs(1500));
+    int total = 0;
+    MakeStream::range(0, 2048) | for_each([&](int x) { total += x; });
+    EXPECT_THAT(total, Eq(2096128));
+}
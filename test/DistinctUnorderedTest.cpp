@@ -0,0 +1,66 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+TEST(DistinctUnorderedTest, KeepsFirstOccurrences) {
+    EXPECT_THAT(MakeStream::from({3, 1, 3, 2, 1, 5, 2}) | distinct_unordered() | to_vector(),
+                ElementsAre(3, 1, 2, 5));
+    EXPECT_THAT(MakeStream::empty<int>() | distinct_unordered() | to_vector(), IsEmpty());
+}
+
+TEST(DistinctUnorderedTest, Infinite) {
+    EXPECT_THAT(MakeStream::counter(0)
+                    | map_([](int x) { return x % 4; })
+                    | distinct_unordered()
+                    | limit(4)
+                    | to_vector(),
+                ElementsAre(0, 1, 2, 3));
+}
+
+TEST(DistinctUnorderedTest, Strings) {
+    std::vector<std::string> words = {"b", "a", "b", "c", "a"};
+    EXPECT_THAT(MakeStream::from(words) | distinct_unordered() | to_vector(),
+                ElementsAre("b", "a", "c"));
+}
+
+TEST(DistinctUnorderedTest, CustomHashAndEqual) {
+    auto lower = [](const std::string& s) {
+        std::string result = s;
+        for(auto& c : result) {
+            c = std::tolower(c);
+        }
+        return result;
+    };
+    auto hash = [lower](const std::string& s) { return std::hash<std::string>()(lower(s)); };
+    auto equal = [lower](const std::string& a, const std::string& b) { return lower(a) == lower(b); };
+    std::vector<std::string> words = {"Apple", "apple", "PEAR", "pear", "Fig"};
+    EXPECT_THAT(MakeStream::from(words) | distinct_unordered(hash, equal) | to_vector(),
+                ElementsAre("Apple", "PEAR", "Fig"));
+}
+
+TEST(DistinctUnorderedTest, ManyElements) {
+    auto result = MakeStream::range(0, 100000)
+        | map_([](int x) { return (x * 7919) % 20000; })
+        | distinct_unordered()
+        | to_vector();
+    EXPECT_THAT(result, SizeIs(20000));
+    std::sort(result.begin(), result.end());
+    EXPECT_THAT(result, ElementsAreArray(MakeStream::range(0, 20000) | to_vector()));
+}
+
+TEST(DistinctUnorderedTest, ElementWise) {
+    auto stream = MakeStream::from({1, 1, 2, 1, 3}) | distinct_unordered();
+    std::vector<int> result;
+    for(int x : stream) {
+        result.push_back(x);
+    }
+    EXPECT_THAT(result, ElementsAre(1, 2, 3));
+}
@@ -0,0 +1,122 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+TEST(ExecutorTest, RunsTasks) {
+    exec::ThreadPool pool(3);
+    EXPECT_THAT(pool.concurrency(), Eq(3));
+
+    std::atomic<int> total{0};
+    {
+        exec::TaskGroup group(pool);
+        for(int i = 1; i <= 100; i++) {
+            group.run([&total, i] { total += i; });
+        }
+        group.wait();
+    }
+    EXPECT_THAT(total.load(), Eq(5050));
+}
+
+TEST(ExecutorTest, RethrowsFirstError) {
+    exec::ThreadPool pool(2);
+    exec::TaskGroup group(pool);
+    std::atomic<int> ran{0};
+    for(int i = 0; i < 10; i++) {
+        group.run([&ran, i] {
+            ran++;
+            if(i == 4) {
+                throw std::runtime_error("task");
+            }
+        });
+    }
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    EXPECT_THAT(ran.load(), Eq(10));
+    EXPECT_NO_THROW(group.wait());
+}
+
+TEST(ExecutorTest, NestedGroups) {
+    exec::ThreadPool pool(2);
+    std::atomic<int> total{0};
+    exec::TaskGroup outer(pool);
+    for(int i = 0; i < 8; i++) {
+        outer.run([&pool, &total] {
+            exec::TaskGroup inner(pool);
+            for(int j = 0; j < 8; j++) {
+                inner.run([&total] { total++; });
+            }
+            inner.wait();
+        });
+    }
+    outer.wait();
+    EXPECT_THAT(total.load(), Eq(64));
+}
+
+TEST(ExecutorTest, WaitRunsOnlyItsOwnTasks) {
+    exec::ThreadPool pool(1);
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    auto blocking = [&started, &release] {
+        started = true;
+        while(!release) {
+            std::this_thread::yield();
+        }
+    };
+    exec::TaskGroup other(pool);
+    other.run(blocking);
+    while(!started) {
+        std::this_thread::yield();
+    }
+
+    // The only worker is busy, so the wait has to run the group's task
+    // itself, and must not pick up the blocking one queued after it.
+    std::atomic<int> ran{0};
+    exec::TaskGroup group(pool);
+    group.run([&ran] { ran++; });
+    other.run(blocking);
+    group.wait();
+    EXPECT_THAT(ran.load(), Eq(1));
+
+    release = true;
+    other.wait();
+}
+
+TEST(ExecutorTest, PipelinesOnPool) {
+    exec::ThreadPool pool(4, true);
+    EXPECT_THAT(MakeStream::range(0, 100000)
+                    | map_([](int x) { return (long) x; })
+                    | parallel_sum().on(pool),
+                Eq(4999950000L));
+    EXPECT_THAT(MakeStream::range(0, 1000) | parallel_count().on(pool), Eq(1000));
+    EXPECT_TRUE(MakeStream::range(0, 1000)
+                    | parallel_any([](int x) { return x == 999; }).on(pool));
+}
+
+TEST(ExecutorTest, SharedPool) {
+    exec::ThreadPool pool(2);
+    std::vector<long> results(6);
+    std::vector<std::thread> callers;
+    for(size_t i = 0; i < results.size(); i++) {
+        callers.emplace_back([&pool, &results, i] {
+            results[i] = MakeStream::range(0, 20000)
+                | map_([i](int x) { return (long) (x % (i + 2)); })
+                | parallel_sum().on(pool);
+        });
+    }
+    for(auto& caller : callers) {
+        caller.join();
+    }
+    for(size_t i = 0; i < results.size(); i++) {
+        long expected = MakeStream::range(0, 20000)
+            | map_([i](int x) { return (long) (x % (i + 2)); })
+            | sum();
+        EXPECT_THAT(results[i], Eq(expected));
+    }
+}
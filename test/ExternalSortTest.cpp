@@ -0,0 +1,87 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+TEST(ExternalSortTest, FitsInMemory) {
+    EXPECT_THAT(MakeStream::from({3, 1, 2}) | external_sort(1 << 20) | to_vector(),
+                ElementsAre(1, 2, 3));
+    EXPECT_THAT(MakeStream::empty<int>() | external_sort(1 << 20) | to_vector(), IsEmpty());
+}
+
+TEST(ExternalSortTest, SpillsRuns) {
+    std::mt19937 engine(11);
+    std::vector<int> input(100000);
+    for(auto& x : input) {
+        x = static_cast<int>(engine());
+    }
+    auto expected = input;
+    std::sort(expected.begin(), expected.end());
+    // About 4KB per run, so the input is cut into about a hundred runs.
+    auto stream = MakeStream::from(input) | external_sort(4096);
+    EXPECT_THAT(stream.pipeline(), HasSubstr("ExternalSort[4096 bytes]"));
+    EXPECT_THAT(std::move(stream) | to_vector(), Eq(expected));
+}
+
+TEST(ExternalSortTest, MergesInPasses) {
+#if defined(__linux__)
+    // Far fewer files than runs may be open at once.
+    rlimit original;
+    getrlimit(RLIMIT_NOFILE, &original);
+    rlimit lowered = original;
+    lowered.rlim_cur = std::min<rlim_t>(original.rlim_cur, 256);
+    setrlimit(RLIMIT_NOFILE, &lowered);
+#endif
+    std::mt19937 engine(12);
+    std::vector<int> input(200000);
+    for(auto& x : input) {
+        x = static_cast<int>(engine());
+    }
+    auto expected = input;
+    std::sort(expected.begin(), expected.end());
+    // 64 elements per run, so about 3000 runs and two generations of merges.
+    auto result = MakeStream::from(input) | external_sort(256) | to_vector();
+#if defined(__linux__)
+    setrlimit(RLIMIT_NOFILE, &original);
+#endif
+    EXPECT_THAT(result, Eq(expected));
+}
+
+TEST(ExternalSortTest, CustomLess) {
+    auto result = MakeStream::range(0, 10000)
+        | external_sort(1000, std::greater<int>())
+        | limit(3)
+        | to_vector();
+    EXPECT_THAT(result, ElementsAre(9999, 9998, 9997));
+}
+
+TEST(ExternalSortTest, Strings) {
+    std::vector<std::string> input;
+    for(int i = 0; i < 5000; i++) {
+        input.push_back(std::to_string((i * 7919) % 5000) + std::string(i % 7, 'x'));
+    }
+    auto expected = input;
+    std::sort(expected.begin(), expected.end());
+    EXPECT_THAT(MakeStream::from(input) | external_sort(8192) | to_vector(), Eq(expected));
+}
+
+TEST(ExternalSortTest, SizeHint) {
+    auto stream = MakeStream::range(0, 2000) | map_([](int x) { return -x; })
+        | external_sort(512);
+    auto& source = stream.getSource();
+    EXPECT_THAT(source->size_hint(), Eq(2000));
+    ASSERT_TRUE(source->advance());
+    EXPECT_THAT(source->value(), Eq(-1999));
+    EXPECT_THAT(source->size_hint(), Eq(1999));
+}
@@ -0,0 +1,76 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <string>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+TEST(ParallelDistinctTest, Distinct) {
+    exec::ThreadPool pool(4);
+    auto result = MakeStream::range(0, 100000)
+        | map_([](int x) { return x % 1000; })
+        | parallel_distinct().on(pool)
+        | to_vector();
+    std::sort(result.begin(), result.end());
+    EXPECT_THAT(result, Eq(MakeStream::range(0, 1000) | to_vector()));
+
+    EXPECT_THAT(MakeStream::from({"a", "b", "a"})
+                    | map_([](const char* s) { return std::string(s); })
+                    | parallel_distinct()
+                    | count(),
+                Eq(2));
+    EXPECT_THAT(MakeStream::empty<int>() | parallel_distinct() | to_vector(),
+                IsEmpty());
+}
+
+TEST(ParallelDistinctTest, CustomEquality) {
+    exec::ThreadPool pool(3);
+    auto mod_ten = [](int x) { return std::hash<int>()(x % 10); };
+    auto same_digit = [](int a, int b) { return a % 10 == b % 10; };
+    auto result = MakeStream::range(0, 5000)
+        | parallel_distinct(mod_ten, same_digit).on(pool)
+        | map_([](int x) { return x % 10; })
+        | to_vector();
+    std::sort(result.begin(), result.end());
+    EXPECT_THAT(result, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST(ParallelDistinctTest, ElementByElement) {
+    exec::ThreadPool pool(2);
+    auto stream = MakeStream::from({3, 1, 3, 2, 1}) | parallel_distinct().on(pool);
+    std::vector<int> result;
+    for(int x : stream) {
+        result.push_back(x);
+    }
+    EXPECT_THAT(result, UnorderedElementsAre(1, 2, 3));
+}
+
+TEST(ParallelDistinctTest, UnorderedSet) {
+    exec::ThreadPool pool(4);
+    auto keys = MakeStream::range(0, 200000)
+        | map_([](int x) { return std::to_string(x % 5000); })
+        | parallel_to_unordered_set().on(pool);
+    EXPECT_THAT(keys.size(), Eq(5000u));
+    EXPECT_THAT(keys.count("4999"), Eq(1u));
+
+    auto expected = MakeStream::range(0, 20000)
+        | map_([](int x) { return x % 300; })
+        | to_unordered_set();
+    EXPECT_THAT(MakeStream::range(0, 20000)
+                    | map_([](int x) { return x % 300; })
+                    | parallel_to_unordered_set().on(pool),
+                Eq(expected));
+}
+
+TEST(ParallelDistinctTest, UnorderedMultiset) {
+    exec::ThreadPool pool(4);
+    auto values = MakeStream::range(0, 30000)
+        | map_([](int x) { return x % 100; })
+        | parallel_to_unordered_multiset().on(pool);
+    EXPECT_THAT(values.size(), Eq(30000u));
+    EXPECT_THAT(values.count(42), Eq(300u));
+}
@@ -0,0 +1,80 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+auto expand = [](int x) { return MakeStream::repeat(x, x % 5); };
+
+TEST(ParallelFlatMapTest, Ordered) {
+    exec::ThreadPool pool(4);
+    auto expected = MakeStream::range(0, 2000) | flat_map(expand) | to_vector();
+    EXPECT_THAT(MakeStream::range(0, 2000)
+                    | parallel_flat_map(expand).on(pool)
+                    | to_vector(),
+                Eq(expected));
+    EXPECT_THAT(MakeStream::range(0, 2000)
+                    | parallel_flat_map(expand, 2).on(pool)
+                    | to_vector(),
+                Eq(expected));
+}
+
+TEST(ParallelFlatMapTest, Unordered) {
+    exec::ThreadPool pool(4);
+    auto expected = MakeStream::range(0, 2000) | flat_map(expand) | to_vector();
+    auto result = MakeStream::range(0, 2000)
+        | parallel_flat_map([](int x) {
+            if(x % 7 == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+            return MakeStream::repeat(x, x % 5);
+        }, 0, false).on(pool)
+        | to_vector();
+    std::sort(result.begin(), result.end());
+    EXPECT_THAT(result, Eq(expected));
+}
+
+TEST(ParallelFlatMapTest, StaticInner) {
+    exec::ThreadPool pool(2);
+    std::vector<int> digits = {1, 2, 3};
+    auto result = MakeStream::from({10, 20})
+        | parallel_flat_map([&digits](int x) {
+            return MakeStream::static_from(digits)
+                | map_([x](int d) { return x + d; });
+        }).on(pool)
+        | to_vector();
+    EXPECT_THAT(result, ElementsAre(11, 12, 13, 21, 22, 23));
+}
+
+TEST(ParallelFlatMapTest, EmptyExpansions) {
+    EXPECT_THAT(MakeStream::range(0, 100)
+                    | parallel_flat_map([](int) { return MakeStream::empty<int>(); })
+                    | to_vector(),
+                IsEmpty());
+}
+
+TEST(ParallelFlatMapTest, Exception) {
+    exec::ThreadPool pool(2);
+    auto stream = MakeStream::range(0, 100)
+        | parallel_flat_map([](int x) {
+            if(x == 40) {
+                throw std::runtime_error("expand");
+            }
+            return MakeStream::repeat(x, 2);
+        }).on(pool);
+    std::vector<int> seen;
+    auto read = [&] {
+        for(int x : stream) {
+            seen.push_back(x);
+        }
+    };
+    EXPECT_THROW(read(), std::runtime_error);
+    EXPECT_THAT(seen.size(), Eq(80u));
+}
@@ -0,0 +1,174 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+TEST(ParallelMapTest, PreservesOrder) {
+    exec::ThreadPool pool(4);
+    auto square = [](int x) { return x * x; };
+    auto expected = MakeStream::range(0, 5000) | map_(square) | to_vector();
+    EXPECT_THAT(MakeStream::range(0, 5000)
+                    | parallel_map(square, 3).on(pool)
+                    | to_vector(),
+                Eq(expected));
+    EXPECT_THAT(MakeStream::range(0, 5000)
+                    | parallel_map(square).on(pool)
+                    | filter([](int x) { return x % 2 == 0; })
+                    | count(),
+                Eq(2500));
+}
+
+TEST(ParallelMapTest, ElementByElement) {
+    exec::ThreadPool pool(2);
+    auto stream = MakeStream::from({1, 2, 3})
+        | parallel_map([](int x) { return std::to_string(x); }).on(pool);
+    std::vector<std::string> result;
+    for(auto& element : stream) {
+        result.push_back(element);
+    }
+    EXPECT_THAT(result, ElementsAre("1", "2", "3"));
+}
+
+TEST(ParallelMapTest, Empty) {
+    EXPECT_THAT(MakeStream::empty<int>()
+                    | parallel_map([](int x) { return x; })
+                    | to_vector(),
+                IsEmpty());
+}
+
+TEST(ParallelMapTest, Limit) {
+    exec::ThreadPool pool(2);
+    EXPECT_THAT(MakeStream::counter(0)
+                    | parallel_map([](int x) { return x + 1; }).on(pool)
+                    | limit(5)
+                    | to_vector(),
+                ElementsAre(1, 2, 3, 4, 5));
+}
+
+TEST(ParallelMapTest, Exception) {
+    exec::ThreadPool pool(2);
+    auto stream = MakeStream::range(0, 1000)
+        | parallel_map([](int x) {
+            if(x == 700) {
+                throw std::runtime_error("map");
+            }
+            return x;
+        }).on(pool);
+    std::vector<int> seen;
+    auto read = [&] {
+        for(int x : stream) {
+            seen.push_back(x);
+        }
+    };
+    EXPECT_THROW(read(), std::runtime_error);
+    EXPECT_THAT(seen.size(), Eq(700));
+}
+
+TEST(ParallelMapTest, RequestStop) {
+    exec::ThreadPool pool(2);
+    EXPECT_THAT(MakeStream::range(0, 1000)
+                    | parallel_map([](int x) {
+                        if(x == 300) {
+                            request_stop();
+                        }
+                        return x;
+                    }).on(pool)
+                    | to_vector(),
+                SizeIs(301));
+}
+
+TEST(ParallelMapTest, SizeHint) {
+    auto stream = MakeStream::range(0, 100)
+        | parallel_map([](int x) { return x; });
+    EXPECT_THAT(stream.getSource()->size_hint(), Eq(100));
+    EXPECT_THAT(stream | count(), Eq(100));
+}
+
+TEST(ParallelMapTest, Unordered) {
+    exec::ThreadPool pool(4);
+    auto slow_evens = [](int x) {
+        if(x % 2 == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        }
+        return x * 3;
+    };
+    auto result = MakeStream::range(0, 3000)
+        | parallel_map_unordered(slow_evens).on(pool)
+        | to_vector();
+    std::sort(result.begin(), result.end());
+    auto expected = MakeStream::range(0, 3000)
+        | map_([](int x) { return x * 3; })
+        | to_vector();
+    EXPECT_THAT(result, Eq(expected));
+
+    EXPECT_THAT(MakeStream::range(0, 1000)
+                    | parallel_map_unordered([](int x) { return (long) x; }).on(pool)
+                    | sum(),
+                Eq(499500L));
+}
+
+TEST(ParallelMapTest, Filter) {
+    exec::ThreadPool pool(3);
+    auto multiples = MakeStream::range(0, 10000)
+        | parallel_filter([](int x) { return x % 7 == 0; }).on(pool)
+        | to_unordered_set();
+    EXPECT_THAT(multiples.size(), Eq(1429u));
+    EXPECT_THAT(multiples.count(7 * 1000), Eq(1u));
+    EXPECT_THAT(multiples.count(8), Eq(0u));
+
+    EXPECT_THAT(MakeStream::range(0, 10000)
+                    | parallel_filter([](int x) { return x % 2 == 1; }).on(pool)
+                    | count(),
+                Eq(5000));
+    EXPECT_THAT(MakeStream::from({true, false, true}) | parallel_filter() | count(),
+                Eq(2));
+
+    std::vector<int> input = {1, 2, 3, 4, 5, 6};
+    auto evens = MakeStream::static_from(input)
+        | map_([](int x) { return x * 10; })
+        | parallel_filter([](int x) { return x % 20 == 0; }).on(pool)
+        | to_vector();
+    std::sort(evens.begin(), evens.end());
+    EXPECT_THAT(evens, ElementsAre(20, 40, 60));
+}
+
+TEST(ParallelMapTest, DropsUnstartedChunksWhenDestroyed) {
+    exec::ThreadPool pool(1);
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    exec::TaskGroup busy(pool);
+    busy.run([&started, &release] {
+        started = true;
+        while(!release) {
+            std::this_thread::yield();
+        }
+    });
+    while(!started) {
+        std::this_thread::yield();
+    }
+
+    // The only worker is busy, so the first chunk is transformed on this
+    // thread and the other three are still queued when first() is done.
+    std::atomic<int> transformed{0};
+    int head = MakeStream::range(0, 1000)
+        | parallel_map([&transformed](int x) {
+              transformed++;
+              return x;
+          }, 4).on(pool)
+        | first();
+    EXPECT_THAT(head, Eq(0));
+    EXPECT_THAT(transformed.load(), Eq(64));
+
+    release = true;
+    busy.wait();
+}
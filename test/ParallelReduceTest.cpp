@@ -0,0 +1,88 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+std::vector<int> numbers(int n) {
+    std::vector<int> result(n);
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+}
+
+TEST(ParallelReduceTest, Sum) {
+    auto input = numbers(100000);
+    EXPECT_THAT(MakeStream::from(input) | map_([](int x) { return (long) x; })
+                                        | parallel_sum(),
+                Eq(4999950000L));
+    EXPECT_THAT(MakeStream::from(input) | parallel_sum(0L), Eq(4999950000L));
+    EXPECT_THAT(MakeStream::empty<int>() | parallel_sum(7), Eq(7));
+    EXPECT_THROW(MakeStream::empty<int>() | parallel_sum(), EmptyStreamException);
+}
+
+TEST(ParallelReduceTest, CombinesInOrder) {
+    auto input = numbers(5000);
+    auto to_string = [](int x) { return std::to_string(x % 10); };
+    auto expected = MakeStream::from(input) | map_(to_string) | sum();
+    EXPECT_THAT(MakeStream::from(input) | map_(to_string) | parallel_sum(),
+                Eq(expected));
+    EXPECT_THAT(MakeStream::from(input)
+                    | parallel_identity_reduce(std::string(),
+                          [=](std::string s, int x) { return s + to_string(x); },
+                          std::plus<std::string>()),
+                Eq(expected));
+    EXPECT_THAT(MakeStream::from(input)
+                    | parallel_reduce(to_string,
+                          [=](std::string s, int x) { return s + to_string(x); },
+                          std::plus<std::string>()),
+                Eq(expected));
+}
+
+TEST(ParallelReduceTest, Count) {
+    EXPECT_THAT(MakeStream::from(numbers(12345)) | parallel_count(), Eq(12345));
+    EXPECT_THAT(MakeStream::from(numbers(12345))
+                    | filter([](int x) { return x % 5 == 0; })
+                    | parallel_count(),
+                Eq(2469));
+    EXPECT_THAT(MakeStream::empty<int>() | parallel_count(), Eq(0));
+}
+
+TEST(ParallelReduceTest, MinMax) {
+    auto input = numbers(10000);
+    std::reverse(input.begin() + 3000, input.end());
+    EXPECT_THAT(MakeStream::from(input) | parallel_max(), Eq(9999));
+    EXPECT_THAT(MakeStream::from(input) | parallel_min(), Eq(0));
+    EXPECT_THAT(MakeStream::from(input) | parallel_max(std::greater<int>()), Eq(0));
+}
+
+TEST(ParallelReduceTest, Quantifiers) {
+    auto input = numbers(50000);
+    EXPECT_THAT(MakeStream::from(input) | parallel_any([](int x) { return x == 40000; }),
+                Eq(true));
+    EXPECT_THAT(MakeStream::from(input) | parallel_any([](int x) { return x < 0; }),
+                Eq(false));
+    EXPECT_THAT(MakeStream::from(input) | parallel_all([](int x) { return x >= 0; }),
+                Eq(true));
+    EXPECT_THAT(MakeStream::from(input) | parallel_all([](int x) { return x < 100; }),
+                Eq(false));
+    EXPECT_THAT(MakeStream::counter(0) | parallel_any([](int x) { return x == 5000; }),
+                Eq(true));
+    EXPECT_THAT(MakeStream::empty<bool>() | parallel_all(), Eq(true));
+}
+
+TEST(ParallelReduceTest, Exceptions) {
+    auto throwing = [](int a, int b) -> int {
+        if(b == 3000) {
+            throw std::runtime_error("boom");
+        }
+        return a + b;
+    };
+    EXPECT_THROW(MakeStream::from(numbers(10000)) | parallel_reduce(throwing),
+                 std::runtime_error);
+}
@@ -0,0 +1,68 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+std::vector<int> shuffled(int n) {
+    std::vector<int> result(n);
+    std::iota(result.begin(), result.end(), 0);
+    std::shuffle(result.begin(), result.end(), std::mt19937(7));
+    return result;
+}
+
+TEST(ParallelSortTest, Small) {
+    EXPECT_THAT(MakeStream::from({3, 1, 2}) | parallel_sort() | to_vector(),
+                ElementsAre(1, 2, 3));
+    EXPECT_THAT(MakeStream::from({3, 1, 2}) | parallel_sort(std::greater<int>())
+                                            | to_vector(),
+                ElementsAre(3, 2, 1));
+    EXPECT_THAT(MakeStream::empty<int>() | parallel_sort() | to_vector(), IsEmpty());
+}
+
+TEST(ParallelSortTest, Large) {
+    for(size_t threads : {2, 3, 5}) {
+        exec::ThreadPool pool(threads);
+        auto input = shuffled(100000);
+        auto expected = input;
+        std::sort(expected.begin(), expected.end());
+        EXPECT_THAT(MakeStream::from(input) | parallel_sort().on(pool) | to_vector(),
+                    Eq(expected));
+    }
+}
+
+TEST(ParallelSortTest, MoveOnly) {
+    exec::ThreadPool pool(4);
+    auto input = shuffled(20000);
+    auto result = MakeStream::from(input)
+        | map_([](int x) { return std::make_unique<int>(x); })
+        | parallel_sort([](const auto& a, const auto& b) { return *a < *b; }).on(pool)
+        | map_([](std::unique_ptr<int> p) { return *p; })
+        | to_vector();
+    EXPECT_TRUE(std::is_sorted(result.begin(), result.end()));
+    EXPECT_THAT(result.size(), Eq(20000u));
+}
+
+TEST(ParallelSortTest, ElementByElement) {
+    exec::ThreadPool pool(2);
+    auto input = shuffled(10000);
+    auto stream = MakeStream::from(input) | parallel_sort().on(pool);
+    int expected = 0;
+    for(int x : stream) {
+        ASSERT_THAT(x, Eq(expected++));
+    }
+    EXPECT_THAT(expected, Eq(10000));
+}
+
+TEST(ParallelSortTest, Limit) {
+    auto input = shuffled(100);
+    EXPECT_THAT(MakeStream::from(input) | parallel_sort() | limit(3) | to_vector(),
+                ElementsAre(0, 1, 2));
+}
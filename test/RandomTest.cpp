@@ -0,0 +1,88 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <random>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+TEST(RandomTest, PhiloxKnownAnswers) {
+    EXPECT_THAT(random::Philox::block({{0, 0, 0, 0}}, {{0, 0}}),
+                ElementsAre(0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8));
+    EXPECT_THAT(random::Philox::block({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+                                      {{0xffffffff, 0xffffffff}}),
+                ElementsAre(0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd));
+    EXPECT_THAT(random::Philox::block({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}},
+                                      {{0xa4093822, 0x299f31d0}}),
+                ElementsAre(0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1));
+}
+
+TEST(RandomTest, PhiloxDiscard) {
+    random::Philox drawn(42);
+    std::vector<std::uint32_t> expected;
+    for(int i = 0; i < 20; i++) {
+        expected.push_back(drawn());
+    }
+    for(int skipped = 0; skipped < 20; skipped++) {
+        random::Philox jumped(42);
+        jumped.discard(skipped);
+        EXPECT_THAT(jumped(), Eq(expected[skipped]));
+    }
+}
+
+TEST(RandomTest, PhiloxSubstreams) {
+    random::Philox engine(7);
+    auto first = engine.substream(1);
+    auto again = random::Philox(7, 1);
+    auto other = engine.substream(2);
+    EXPECT_TRUE(first == again);
+    EXPECT_TRUE(first != other);
+    std::uint32_t a = first(), b = again(), c = other();
+    EXPECT_THAT(a, Eq(b));
+    EXPECT_THAT(a, Ne(c));
+}
+
+TEST(RandomTest, Seeded) {
+    auto draw = [] {
+        return MakeStream::uniform_random_ints<random::Philox>(0, 1000, 99)
+            | limit(50) | to_vector();
+    };
+    auto values = draw();
+    EXPECT_THAT(values, Each(AllOf(Ge(0), Le(1000))));
+    EXPECT_THAT(draw(), Eq(values));
+    EXPECT_THAT(MakeStream::uniform_random_ints<random::Philox>(0, 1000, 99)
+                    | skip(30) | limit(20) | to_vector(),
+                ElementsAreArray(values.begin() + 30, values.end()));
+}
+
+TEST(RandomTest, CountedSplitsIdentically) {
+    auto whole = MakeStream::counted_randoms<double, std::normal_distribution>(
+        1000, 5, 0.0, 1.0) | to_vector();
+    ASSERT_THAT(whole, SizeIs(1000));
+
+    auto stream = MakeStream::counted_randoms<double, std::normal_distribution>(
+        1000, 5, 0.0, 1.0);
+    auto& source = stream.getSource();
+    auto prefix = source->try_split();
+    ASSERT_TRUE(prefix);
+    EXPECT_THAT(prefix->size_hint(), Eq(500));
+    std::vector<double> pieces;
+    prefix->advance_batch(pieces, 1000);
+    source->advance_batch(pieces, 1000);
+    EXPECT_THAT(pieces, Eq(whole));
+}
+
+TEST(RandomTest, ParallelMatchesSequential) {
+    auto ints = [] {
+        return MakeStream::counted_randoms<long, std::uniform_int_distribution>(
+            100000, 3, 0L, 1000000L);
+    };
+    long expected = ints() | sum();
+    for(size_t threads : {1, 2, 4}) {
+        exec::ThreadPool pool(threads);
+        EXPECT_THAT(ints() | parallel_sum().on(pool), Eq(expected));
+    }
+}
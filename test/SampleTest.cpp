@@ -2,6 +2,8 @@
 
 #include <gmock/gmock.h>
 
+#include <algorithm>
+
 using namespace testing;
 using namespace stream;
 using namespace stream::op;
@@ -32,3 +34,65 @@ TEST(SampleTest, RandomElement) {
     EXPECT_THAT(MakeStream::closed_range(1, 10) | random_element(), IsBetween(1, 10));
     EXPECT_EXCEPTION(MakeStream::empty<int>() | random_element(), EmptyStreamException);
 }
+
+// How often each tenth of 0..n-1 is picked from in repeated samples of 3,
+// which should be close to 3/10 of the trials for every tenth.
+template<typename Sampler>
+std::vector<int> pick_counts(Sampler&& sampler, int n, int trials) {
+    std::vector<int> counts(10);
+    for(int seed = 0; seed < trials; seed++) {
+        for(int value : sampler(seed)) {
+            counts[value * 10 / n]++;
+        }
+    }
+    return counts;
+}
+
+TEST(SampleTest, SeededRandomSample) {
+    auto sample = MakeStream::range(0, 100000) | random_sample(20, 17);
+    EXPECT_THAT(sample, SizeIs(20));
+    EXPECT_THAT(sample, Each(AllOf(Ge(0), Lt(100000))));
+    EXPECT_THAT(MakeStream::range(0, 100000) | random_sample(20, 17), Eq(sample));
+    EXPECT_THAT(MakeStream::range(0, 100000) | random_sample(0, 17), IsEmpty());
+}
+
+TEST(SampleTest, RandomSampleIsUniform) {
+    auto counts = pick_counts([](int seed) {
+        return MakeStream::range(0, 10) | random_sample(3, seed);
+    }, 10, 20000);
+    EXPECT_THAT(counts, Each(AllOf(Gt(5600), Lt(6400))));
+
+    counts = pick_counts([](int seed) {
+        return MakeStream::range(0, 1000) | random_sample(3, seed);
+    }, 1000, 20000);
+    EXPECT_THAT(counts, Each(AllOf(Gt(5600), Lt(6400))));
+}
+
+TEST(SampleTest, ParallelRandomSample) {
+    exec::ThreadPool pool(4);
+    auto sample = MakeStream::range(0, 100000) | parallel_random_sample(50, 3).on(pool);
+    EXPECT_THAT(sample, SizeIs(50));
+    std::sort(sample.begin(), sample.end());
+    EXPECT_THAT(std::adjacent_find(sample.begin(), sample.end()), Eq(sample.end()));
+    EXPECT_THAT(sample, Each(AllOf(Ge(0), Lt(100000))));
+
+    EXPECT_THAT(MakeStream::range(0, 5) | parallel_random_sample(10).on(pool),
+                UnorderedElementsAre(0, 1, 2, 3, 4));
+    EXPECT_THAT(MakeStream::empty<int>() | parallel_random_sample(10).on(pool), IsEmpty());
+}
+
+TEST(SampleTest, ParallelRandomSampleIsUniform) {
+    exec::ThreadPool pool(4);
+    auto split = pick_counts([&pool](int seed) {
+        return MakeStream::range(0, 1000) | parallel_random_sample(3, seed).on(pool);
+    }, 1000, 5000);
+    EXPECT_THAT(split, Each(AllOf(Gt(1300), Lt(1700))));
+
+    // A filter cannot be split, so workers take turns pulling from it.
+    auto shared = pick_counts([&pool](int seed) {
+        return MakeStream::range(0, 5000)
+            | filter([](int x) { return x % 2 == 0; })
+            | parallel_random_sample(3, seed).on(pool);
+    }, 5000, 5000);
+    EXPECT_THAT(shared, Each(AllOf(Gt(1300), Lt(1700))));
+}
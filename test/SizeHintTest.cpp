@@ -0,0 +1,126 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <list>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+template<typename S>
+size_t hint(S& stream) {
+    return stream.getSource()->size_hint();
+}
+
+template<typename S>
+bool exact(S& stream) {
+    return stream.getSource()->exact_size();
+}
+
+TEST(SizeHintTest, Sources) {
+    std::vector<int> input = {1, 2, 3, 4};
+    auto vector = MakeStream::from(input);
+    EXPECT_THAT(hint(vector), Eq(4));
+    EXPECT_THAT(exact(vector), Eq(true));
+    vector.getSource()->advance();
+    EXPECT_THAT(hint(vector), Eq(3));
+
+    std::list<int> list = {1, 2};
+    auto listed = MakeStream::from(list);
+    EXPECT_THAT(exact(listed), Eq(false));
+
+    auto cycled = MakeStream::cycle({1, 2, 3}, 2);
+    EXPECT_THAT(hint(cycled), Eq(6));
+    EXPECT_THAT(exact(cycled), Eq(true));
+    cycled.getSource()->advance();
+    cycled.getSource()->advance();
+    EXPECT_THAT(hint(cycled), Eq(4));
+
+    auto forever = MakeStream::cycle({1, 2, 3});
+    EXPECT_THAT(exact(forever), Eq(false));
+
+    auto single = MakeStream::singleton(5);
+    EXPECT_THAT(hint(single), Eq(1));
+    auto empty = MakeStream::empty<int>();
+    EXPECT_THAT(hint(empty), Eq(0));
+    EXPECT_THAT(exact(empty), Eq(true));
+}
+
+TEST(SizeHintTest, Stages) {
+    auto mapped = MakeStream::from({1, 2, 3}) | map_([](int x) { return x * 2; });
+    EXPECT_THAT(hint(mapped), Eq(3));
+    EXPECT_THAT(exact(mapped), Eq(false));
+
+    auto peeked = MakeStream::from({1, 2, 3}) | peek([](int x) {});
+    EXPECT_THAT(hint(peeked), Eq(3));
+    EXPECT_THAT(exact(peeked), Eq(false));
+
+    auto filtered = MakeStream::from({1, 2, 3}) | filter([](int x) { return x > 1; });
+    EXPECT_THAT(exact(filtered), Eq(false));
+
+    auto zipped = MakeStream::from({1, 2, 3}) | zip_with(MakeStream::from({1, 2}));
+    EXPECT_THAT(hint(zipped), Eq(2));
+    EXPECT_THAT(exact(zipped), Eq(true));
+
+    auto concatenated = MakeStream::from({1, 2, 3}) | concat(MakeStream::from({1, 2}));
+    EXPECT_THAT(hint(concatenated), Eq(5));
+    EXPECT_THAT(exact(concatenated), Eq(true));
+
+    std::vector<int> seven(7);
+    auto grouped = MakeStream::from(seven) | group<3>();
+    EXPECT_THAT(hint(grouped), Eq(2));
+    auto dynamic = MakeStream::from(seven) | group(2);
+    EXPECT_THAT(hint(dynamic), Eq(3));
+}
+
+TEST(SizeHintTest, Slice) {
+    std::vector<int> input(10);
+    auto sliced = MakeStream::from(input) | slice(2, 8, 2);
+    EXPECT_THAT(hint(sliced), Eq(3));
+    EXPECT_THAT(exact(sliced), Eq(true));
+    sliced.getSource()->advance();
+    EXPECT_THAT(hint(sliced), Eq(2));
+
+    auto short_source = MakeStream::from(input) | slice(6, 20, 3);
+    EXPECT_THAT(hint(short_source), Eq(2));
+    auto past_end = MakeStream::from(input) | skip(20);
+    EXPECT_THAT(hint(past_end), Eq(0));
+
+    auto unbounded = MakeStream::counter(0) | limit(10);
+    EXPECT_THAT(exact(unbounded), Eq(false));
+}
+
+TEST(SizeHintTest, Terminators) {
+    int calls = 0;
+    std::vector<int> input(100);
+    EXPECT_THAT(MakeStream::from(input)
+                    | map_([&](int x) { calls++; return x; })
+                    | count(),
+                Eq(100));
+    EXPECT_THAT(calls, Eq(100));
+    EXPECT_THAT(MakeStream::from(input) | peek([&](int x) { calls++; }) | count(),
+                Eq(100));
+    EXPECT_THAT(calls, Eq(200));
+    EXPECT_THAT(MakeStream::range(0, 10)
+                    | map_([](int x) {
+                          if(x == 3) {
+                              request_stop();
+                          }
+                          return x;
+                      })
+                    | count(),
+                Eq(4));
+    EXPECT_THAT(MakeStream::from(input)
+                    | zip_with(MakeStream::from(input), [&](int x, int y) {
+                          calls++;
+                          return x + y;
+                      })
+                    | count(),
+                Eq(100));
+    EXPECT_THAT(calls, Eq(300));
+    EXPECT_THAT(MakeStream::static_from(input) | slice(0, 10, 2) | count(), Eq(5));
+
+    auto result = MakeStream::from(input) | to_vector();
+    EXPECT_THAT(result.capacity(), Eq(100));
+}
@@ -2,6 +2,8 @@
 
 #include <gmock/gmock.h>
 
+#include <numeric>
+
 using namespace testing;
 using namespace stream;
 using namespace stream::op;
@@ -39,3 +41,26 @@ TEST(SliceTest, Limit) {
     EXPECT_THAT(MakeStream::empty<int>() | limit(20) | to_vector(),
                 IsEmpty());
 }
+
+TEST(SliceTest, Seek) {
+    std::vector<int> input(1000);
+    std::iota(input.begin(), input.end(), 0);
+    EXPECT_THAT(MakeStream::from(input) | skip(990) | to_vector(),
+                ElementsAre(990, 991, 992, 993, 994, 995, 996, 997, 998, 999));
+    EXPECT_THAT(MakeStream::from(input) | slice(100, 600, 250) | to_vector(),
+                ElementsAre(100, 350));
+    EXPECT_THAT(MakeStream::from(input) | nth(777), Eq(777));
+    EXPECT_THAT(MakeStream::static_from(input) | nth(5), Eq(5));
+    EXPECT_THROW(MakeStream::from(input) | nth(1000), EmptyStreamException);
+}
+
+TEST(SliceTest, SeekCycle) {
+    EXPECT_THAT(MakeStream::cycle({1, 2, 3}) | slice(1, 12, 4) | to_vector(),
+                ElementsAre(2, 3, 1));
+    EXPECT_THAT(MakeStream::cycle({1, 2, 3}, 2) | skip(4) | to_vector(),
+                ElementsAre(2, 3));
+    EXPECT_THAT(MakeStream::cycle({1, 2, 3}, 2) | skip(6) | to_vector(),
+                IsEmpty());
+    EXPECT_THAT(MakeStream::cycle({1, 2, 3}, 2) | slice_to_end(0, 5) | to_vector(),
+                ElementsAre(1, 3));
+}
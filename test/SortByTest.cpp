@@ -0,0 +1,90 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+struct Person {
+    std::string name;
+    int age;
+
+    int get_age() const { return age; }
+};
+
+TEST(SortByTest, KeyComputedOncePerElement) {
+    int calls = 0;
+    auto length = [&calls](const std::string& s) {
+        calls++;
+        return s.size();
+    };
+    std::vector<std::string> words = {"kiwi", "fig", "banana", "apple", "plum"};
+    EXPECT_THAT(MakeStream::from(words) | sort_by(length) | to_vector(),
+                ElementsAre("fig", "kiwi", "plum", "apple", "banana"));
+    EXPECT_THAT(calls, Eq(5));
+}
+
+TEST(SortByTest, CustomLess) {
+    std::vector<std::string> words = {"b", "ccc", "aa"};
+    EXPECT_THAT(MakeStream::from(words)
+                    | sort_by([](const std::string& s) { return s.size(); },
+                              std::greater<void>())
+                    | to_vector(),
+                ElementsAre("ccc", "aa", "b"));
+}
+
+TEST(SortByTest, MemberFunction) {
+    std::vector<Person> people = {{"ann", 40}, {"bob", 25}, {"cat", 31}};
+    auto names = MakeStream::from(people)
+        | sort_by(&Person::get_age)
+        | map_([](const Person& p) { return p.name; })
+        | to_vector();
+    EXPECT_THAT(names, ElementsAre("bob", "cat", "ann"));
+}
+
+TEST(SortByTest, NumericKeysKeepOrder) {
+    using P = std::pair<int, int>;
+    std::vector<P> input;
+    for(int i = 0; i < 3000; i++) {
+        input.emplace_back(i, (i * 37) % 11 - 5);
+    }
+    auto expected = input;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const P& a, const P& b) { return a.second < b.second; });
+    EXPECT_THAT(MakeStream::from(input) | sort_by([](const P& p) { return p.second; })
+                    | to_vector(),
+                Eq(expected));
+}
+
+TEST(SortByTest, LongDoubleKeys) {
+    auto key = [](int x) { return static_cast<long double>(x % 11) / 3; };
+    std::vector<int> input = MakeStream::range(0, 1000) | to_vector();
+    auto expected = input;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [&](int a, int b) { return key(a) < key(b); });
+    EXPECT_THAT(MakeStream::from(input) | sort_by(key) | to_vector(), Eq(expected));
+}
+
+TEST(SortByTest, DistinctBy) {
+    std::vector<std::string> words = {"pear", "fig", "kiwi", "yam", "apple", "plum"};
+    EXPECT_THAT(MakeStream::from(words)
+                    | distinct_by([](const std::string& s) { return s.size(); })
+                    | to_vector(),
+                ElementsAre("fig", "pear", "apple"));
+    EXPECT_THAT(MakeStream::empty<std::string>()
+                    | distinct_by([](const std::string& s) { return s.size(); })
+                    | to_vector(),
+                IsEmpty());
+}
+
+TEST(SortByTest, DistinctByManyKeys) {
+    auto result = MakeStream::range(0, 5000)
+        | distinct_by([](int x) { return x % 300; })
+        | to_vector();
+    EXPECT_THAT(result, ElementsAreArray(MakeStream::range(0, 300) | to_vector()));
+}
@@ -0,0 +1,172 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+template<typename T>
+std::vector<T> shuffled(std::vector<T> values) {
+    std::shuffle(values.begin(), values.end(), std::mt19937(1));
+    return values;
+}
+
+template<typename T>
+void expect_sorts(std::vector<T> input) {
+    auto expected = input;
+    std::sort(expected.begin(), expected.end());
+    EXPECT_THAT(MakeStream::from(input) | sort() | to_vector(), Eq(expected));
+    EXPECT_THAT(MakeStream::from(input) | sort(std::less<T>()) | to_vector(), Eq(expected));
+    EXPECT_THAT(MakeStream::from(input) | stable_sort() | to_vector(), Eq(expected));
+}
+
+TEST(SortTest, Small) {
+    EXPECT_THAT(MakeStream::from({3, -1, 2}) | sort() | to_vector(), ElementsAre(-1, 2, 3));
+    EXPECT_THAT(MakeStream::empty<int>() | sort() | to_vector(), IsEmpty());
+    EXPECT_THAT(MakeStream::from({3, -1, 2}) | sort(std::greater<int>()) | to_vector(),
+                ElementsAre(3, 2, -1));
+}
+
+TEST(SortTest, Integers) {
+    std::mt19937_64 engine(7);
+    std::vector<int> ints;
+    std::vector<std::uint64_t> unsigned_longs;
+    std::vector<std::int16_t> shorts;
+    std::vector<signed char> chars;
+    for(int i = 0; i < 5000; i++) {
+        ints.push_back(static_cast<int>(engine()));
+        unsigned_longs.push_back(engine());
+        shorts.push_back(static_cast<std::int16_t>(engine()));
+        chars.push_back(static_cast<signed char>(engine()));
+    }
+    ints.push_back(std::numeric_limits<int>::min());
+    ints.push_back(std::numeric_limits<int>::max());
+    expect_sorts(ints);
+    expect_sorts(unsigned_longs);
+    expect_sorts(shorts);
+    expect_sorts(chars);
+}
+
+TEST(SortTest, SharedHighBytes) {
+    expect_sorts(shuffled(MakeStream::range(0, 1000) | to_vector()));
+}
+
+TEST(SortTest, FloatingPoint) {
+    std::mt19937 engine(3);
+    std::normal_distribution<double> normal(0, 1000);
+    std::vector<double> doubles;
+    std::vector<float> floats;
+    for(int i = 0; i < 3000; i++) {
+        doubles.push_back(normal(engine));
+        floats.push_back(static_cast<float>(normal(engine)));
+    }
+    doubles.push_back(std::numeric_limits<double>::infinity());
+    doubles.push_back(-std::numeric_limits<double>::infinity());
+    doubles.push_back(std::numeric_limits<double>::denorm_min());
+    expect_sorts(doubles);
+    expect_sorts(floats);
+}
+
+TEST(SortTest, LongDouble) {
+    EXPECT_THAT(MakeStream::from(std::vector<long double>{3, 1, 2}) | sort() | to_vector(),
+                ElementsAre(1, 2, 3));
+    std::vector<long double> input;
+    for(int i = 0; i < 1000; i++) {
+        input.push_back((i * 7919) % 1000 - 500.5L);
+    }
+    expect_sorts(input);
+}
+
+TEST(SortTest, SignedZeroesKeepOrder) {
+    std::vector<double> input(300, 1.0);
+    input[100] = 0.0;
+    input[200] = -0.0;
+    auto sorted = MakeStream::from(input) | stable_sort() | to_vector();
+    EXPECT_THAT(sorted[0], Eq(0.0));
+    EXPECT_FALSE(std::signbit(sorted[0]));
+    EXPECT_TRUE(std::signbit(sorted[1]));
+}
+
+TEST(SortTest, Stable) {
+    using P = std::pair<int, int>;
+    std::vector<P> input;
+    for(int i = 0; i < 2000; i++) {
+        input.emplace_back(i % 7, i);
+    }
+    auto by_first = [](const P& a, const P& b) { return a.first < b.first; };
+    auto expected = input;
+    std::stable_sort(expected.begin(), expected.end(), by_first);
+    EXPECT_THAT(MakeStream::from(input) | stable_sort(by_first) | to_vector(), Eq(expected));
+}
+
+TEST(SortTest, Strings) {
+    EXPECT_THAT(MakeStream::from({"pear", "apple", "fig"})
+                    | map_([](const char* s) { return std::string(s); })
+                    | sort()
+                    | to_vector(),
+                ElementsAre("apple", "fig", "pear"));
+}
+
+TEST(SortTest, MoveOnly) {
+    auto sorted = MakeStream::from({3, 1, 2})
+        | map_([](int x) { return std::make_unique<int>(x); })
+        | sort([](const auto& a, const auto& b) { return *a < *b; })
+        | map_([](std::unique_ptr<int>&& p) { return *p; })
+        | to_vector();
+    EXPECT_THAT(sorted, ElementsAre(1, 2, 3));
+}
+
+TEST(SortTest, SizeAndSkip) {
+    auto input = shuffled(MakeStream::range(0, 500) | to_vector());
+    auto stream = MakeStream::from(input) | sort();
+    EXPECT_THAT(stream.getSource()->size_hint(), Eq(500));
+    EXPECT_THAT(std::move(stream) | skip(490) | to_vector(),
+                ElementsAre(490, 491, 492, 493, 494, 495, 496, 497, 498, 499));
+}
+
+TEST(SortTest, TopK) {
+    auto input = shuffled(MakeStream::range(0, 10000) | to_vector());
+    EXPECT_THAT(MakeStream::from(input) | top_k(5) | to_vector(), ElementsAre(0, 1, 2, 3, 4));
+    EXPECT_THAT(MakeStream::from(input) | top_k(3, std::greater<int>()) | to_vector(),
+                ElementsAre(9999, 9998, 9997));
+    EXPECT_THAT(MakeStream::from(input) | top_k(0) | to_vector(), IsEmpty());
+    EXPECT_THAT(MakeStream::from({2, 1}) | top_k(5) | to_vector(), ElementsAre(1, 2));
+}
+
+TEST(SortTest, LimitAfterSort) {
+    auto input = shuffled(MakeStream::range(0, 5000) | to_vector());
+    auto sorted = MakeStream::from(input) | sort();
+    auto limited = std::move(sorted) | limit(3);
+    EXPECT_THAT(limited.pipeline(), HasSubstr("Sort (first 3):"));
+    EXPECT_THAT(std::move(limited) | to_vector(), ElementsAre(0, 1, 2));
+
+    EXPECT_THAT(MakeStream::from(input) | sort() | slice(2000, 2003) | to_vector(),
+                ElementsAre(2000, 2001, 2002));
+    EXPECT_THAT(MakeStream::from(input) | sort() | first(), Eq(0));
+    EXPECT_THAT(MakeStream::from(input) | sort() | nth(4321), Eq(4321));
+    EXPECT_THAT(MakeStream::from(input) | sort() | skip(4998) | to_vector(),
+                ElementsAre(4998, 4999));
+}
+
+TEST(SortTest, StableLimit) {
+    using P = std::pair<int, int>;
+    std::vector<P> input;
+    for(int i = 0; i < 5000; i++) {
+        input.emplace_back((i * 7919) % 13, i);
+    }
+    auto by_first = [](const P& a, const P& b) { return a.first < b.first; };
+    auto expected = input;
+    std::stable_sort(expected.begin(), expected.end(), by_first);
+    expected.resize(1000);
+    EXPECT_THAT(MakeStream::from(input) | stable_sort(by_first) | limit(1000) | to_vector(),
+                Eq(expected));
+}
@@ -0,0 +1,126 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <list>
+#include <numeric>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+template<typename T>
+StreamProviderPtr<T> source_of(Stream<T>&& stream) {
+    return std::move(stream.getSource());
+}
+
+template<typename T>
+std::vector<T> drain(provider::StreamProvider<T>& provider) {
+    std::vector<T> result;
+    while(provider.advance()) {
+        result.push_back(provider.value());
+    }
+    return result;
+}
+
+TEST(SplitTest, Iterator) {
+    std::vector<int> input(10);
+    std::iota(input.begin(), input.end(), 0);
+    auto source = source_of(MakeStream::from(input));
+    auto prefix = source->try_split();
+    ASSERT_THAT(prefix, NotNull());
+    EXPECT_THAT(drain(*prefix), ElementsAre(0, 1, 2, 3, 4));
+    EXPECT_THAT(drain(*source), ElementsAre(5, 6, 7, 8, 9));
+}
+
+TEST(SplitTest, Unsplittable) {
+    std::list<int> input = {1, 2, 3};
+    auto listed = source_of(MakeStream::from(input));
+    EXPECT_THAT(listed->try_split(), IsNull());
+
+    auto started = source_of(MakeStream::from({1, 2, 3, 4}));
+    started->advance();
+    EXPECT_THAT(started->try_split(), IsNull());
+
+    auto single = source_of(MakeStream::from({1}));
+    EXPECT_THAT(single->try_split(), IsNull());
+
+    auto endless = source_of(MakeStream::repeat(1));
+    EXPECT_THAT(endless->try_split(), IsNull());
+}
+
+TEST(SplitTest, Range) {
+    auto source = source_of(MakeStream::range(0, 7));
+    auto prefix = source->try_split();
+    ASSERT_THAT(prefix, NotNull());
+    EXPECT_THAT(drain(*prefix), ElementsAre(0, 1, 2));
+    EXPECT_THAT(drain(*source), ElementsAre(3, 4, 5, 6));
+
+    auto stepped = source_of(MakeStream::range(1, 10, 3));
+    prefix = stepped->try_split();
+    ASSERT_THAT(prefix, NotNull());
+    EXPECT_THAT(drain(*prefix), ElementsAre(1));
+    EXPECT_THAT(drain(*stepped), ElementsAre(4, 7));
+
+    EXPECT_THAT(source_of(MakeStream::counter(0))->try_split(), IsNull());
+}
+
+TEST(SplitTest, Cycle) {
+    auto source = source_of(MakeStream::cycle({1, 2, 3}, 3));
+    auto prefix = source->try_split();
+    ASSERT_THAT(prefix, NotNull());
+    EXPECT_THAT(drain(*prefix), ElementsAre(1, 2, 3));
+    EXPECT_THAT(drain(*source), ElementsAre(1, 2, 3, 1, 2, 3));
+
+    auto once = source_of(MakeStream::cycle({1, 2, 3, 4}, 1));
+    prefix = once->try_split();
+    ASSERT_THAT(prefix, NotNull());
+    EXPECT_THAT(drain(*prefix), ElementsAre(1, 2));
+    EXPECT_THAT(drain(*once), ElementsAre(3, 4));
+}
+
+TEST(SplitTest, Concatenate) {
+    auto source = source_of(MakeStream::from({1, 2})
+        | concat(MakeStream::from({3}))
+        | concat(MakeStream::from({4, 5})));
+    auto prefix = source->try_split();
+    ASSERT_THAT(prefix, NotNull());
+    auto head = drain(*prefix);
+    auto tail = drain(*source);
+    head.insert(head.end(), tail.begin(), tail.end());
+    EXPECT_THAT(head, ElementsAre(1, 2, 3, 4, 5));
+}
+
+TEST(SplitTest, PassThrough) {
+    auto source = source_of(MakeStream::range(0, 8)
+        | filter([](int x) { return x % 2 == 0; })
+        | map_([](int x) { return x * 10; }));
+    auto prefix = source->try_split();
+    ASSERT_THAT(prefix, NotNull());
+    EXPECT_THAT(drain(*prefix), ElementsAre(0, 20));
+    EXPECT_THAT(drain(*source), ElementsAre(40, 60));
+
+    auto limited = source_of(MakeStream::range(0, 8) | limit(4));
+    EXPECT_THAT(limited->try_split(), IsNull());
+}
+
+TEST(SplitTest, ParallelReduce) {
+    auto total = MakeStream::range(0, 100000)
+        | map_([](int x) { return static_cast<long>(x); })
+        | parallel_sum();
+    EXPECT_THAT(total, Eq(4999950000L));
+
+    auto joined = MakeStream::range(0, 3000)
+        | map_([](int x) { return std::vector<int>{x}; })
+        | parallel_reduce([](std::vector<int> a, std::vector<int> b) {
+            a.insert(a.end(), b.begin(), b.end());
+            return a;
+        });
+    std::vector<int> expected(3000);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_THAT(joined, Eq(expected));
+
+    EXPECT_THAT(MakeStream::range(0, 50000)
+        | filter([](int x) { return x % 7 == 0; })
+        | parallel_count(), Eq(7143));
+}
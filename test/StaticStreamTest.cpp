@@ -0,0 +1,61 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+template<typename S>
+struct IsStatic : std::false_type {};
+
+template<typename P>
+struct IsStatic<StaticStream<P>> : std::true_type {};
+
+TEST(StaticStreamTest, Composition) {
+    std::vector<int> input = {1, 2, 3, 4, 5, 6};
+    auto stream = MakeStream::static_from(input)
+        | map_([](int x) { return x * x; })
+        | filter([](int x) { return x % 2 == 0; })
+        | peek([](int x) {})
+        | take_while([](int x) { return x < 100; })
+        | drop_while([](int x) { return x < 4; })
+        | limit(5);
+    EXPECT_THAT(IsStatic<decltype(stream)>::value, Eq(true));
+    EXPECT_THAT(std::move(stream) | to_vector(), ElementsAre(4, 16, 36));
+}
+
+TEST(StaticStreamTest, Terminators) {
+    std::vector<int> input = {1, 2, 3, 4, 5};
+    EXPECT_THAT(MakeStream::static_from(input) | sum(), Eq(15));
+    EXPECT_THAT(MakeStream::static_from(input) | count(), Eq(5));
+    EXPECT_THAT(MakeStream::static_from(input) | skip(1) | first(), Eq(2));
+    EXPECT_THAT(MakeStream::static_from(input) | nth(3), Eq(4));
+    EXPECT_THAT(MakeStream::static_from(input) | map_([](int x) { return x > 3; })
+                                               | any(),
+                Eq(true));
+}
+
+TEST(StaticStreamTest, Erasure) {
+    std::vector<int> input = {3, 1, 2};
+    auto sorted = MakeStream::static_from(input)
+        | map_([](int x) { return x * 10; })
+        | sort();
+    EXPECT_THAT(IsStatic<decltype(sorted)>::value, Eq(false));
+    EXPECT_THAT(std::move(sorted) | to_vector(), ElementsAre(10, 20, 30));
+
+    Stream<int> erased = MakeStream::static_from(input) | filter([](int x) { return x > 1; });
+    EXPECT_THAT(erased | to_vector(), ElementsAre(3, 2));
+
+    EXPECT_THAT(MakeStream::static_from(input)
+                    | concat(MakeStream::from({4, 5}))
+                    | to_vector(),
+                ElementsAre(3, 1, 2, 4, 5));
+}
+
+TEST(StaticStreamTest, Pipeline) {
+    int array[] = {1, 2, 3};
+    auto stream = MakeStream::static_from(array, 3) | map_([](int x) { return x; });
+    EXPECT_THAT(stream.pipeline(),
+                Eq("> Map:\n  > [iterator stream]\nStatic stream pipeline with 1 stage and 1 source."));
+}
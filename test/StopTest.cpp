@@ -0,0 +1,265 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+TEST(StopTest, Generate) {
+    int i = 0;
+    auto stream = MakeStream::generate([&]() {
+        if(i == 3) {
+            request_stop();
+        }
+        return i++;
+    });
+    EXPECT_THAT(std::move(stream) | to_vector(), ElementsAre(0, 1, 2, 3));
+}
+
+TEST(StopTest, LegacyStopStream) {
+    int i = 0;
+    auto stream = MakeStream::generate([&]() {
+        if(i == 3) {
+            throw StopStream();
+        }
+        return i++;
+    });
+    EXPECT_THAT(std::move(stream) | to_vector(), ElementsAre(0, 1, 2));
+}
+
+TEST(StopTest, Map) {
+    auto stop_at_5 = [](int x) {
+        if(x == 5) {
+            request_stop();
+        }
+        return x * 10;
+    };
+    EXPECT_THAT(MakeStream::counter(0) | map_(stop_at_5) | to_vector(),
+                ElementsAre(0, 10, 20, 30, 40, 50));
+    EXPECT_THAT(MakeStream::static_from(std::vector<int>{1, 3, 5, 7})
+                    | map_(stop_at_5)
+                    | to_vector(),
+                ElementsAre(10, 30, 50));
+}
+
+TEST(StopTest, LegacyStopStreamInMap) {
+    auto stop_at_3 = [](int x) {
+        if(x == 3) {
+            throw StopStream();
+        }
+        return x;
+    };
+    EXPECT_THAT(MakeStream::counter(0) | map_(stop_at_3) | to_vector(),
+                ElementsAre(0, 1, 2));
+    int last = -1;
+    for(int x : MakeStream::counter(0) | map_(stop_at_3)) {
+        last = x;
+    }
+    EXPECT_THAT(last, Eq(2));
+    EXPECT_THAT(MakeStream::counter(0)
+                    | map_(stop_at_3)
+                    | filter([](int x) { return x != 1; })
+                    | to_vector(),
+                ElementsAre(0, 2));
+    EXPECT_THAT(MakeStream::counter(0)
+                    | filter([](int x) {
+                          if(x == 3) {
+                              throw StopStream();
+                          }
+                          return x != 1;
+                      })
+                    | to_vector(),
+                ElementsAre(0, 2));
+}
+
+TEST(StopTest, Filter) {
+    auto result = MakeStream::counter(0)
+        | filter([](int x) {
+              if(x == 7) {
+                  request_stop();
+              }
+              return x % 2 == 0;
+          })
+        | to_vector();
+    EXPECT_THAT(result, ElementsAre(0, 2, 4, 6));
+    result = MakeStream::counter(0)
+        | filter([](int x) {
+              if(x == 6) {
+                  request_stop();
+              }
+              return x % 2 == 0;
+          })
+        | to_vector();
+    EXPECT_THAT(result, ElementsAre(0, 2, 4, 6));
+}
+
+TEST(StopTest, FlatMap) {
+    auto result = MakeStream::range(0, 5)
+        | flat_map([](int x) {
+              if(x == 1) {
+                  request_stop();
+              }
+              return MakeStream::range(x * 10, x * 10 + 3);
+          })
+        | to_vector();
+    EXPECT_THAT(result, ElementsAre(0, 1, 2, 10, 11, 12));
+    result = MakeStream::range(0, 5)
+        | flat_map([](int x) {
+              return MakeStream::range(x * 10, x * 10 + 3)
+                  | map_([](int y) {
+                        if(y == 11) {
+                            request_stop();
+                        }
+                        return y;
+                    });
+          })
+        | to_vector();
+    EXPECT_THAT(result, ElementsAre(0, 1, 2, 10, 11));
+}
+
+TEST(StopTest, Concat) {
+    auto stop_at_1 = [](int x) {
+        if(x == 1) {
+            request_stop();
+        }
+        return x;
+    };
+    EXPECT_THAT((MakeStream::range(0, 3) | map_(stop_at_1))
+                    | concat(MakeStream::range(10, 13))
+                    | to_vector(),
+                ElementsAre(0, 1));
+    EXPECT_THAT((MakeStream::range(0, 3) | map_(stop_at_1))
+                    | concat(MakeStream::range(10, 13))
+                    | sum(),
+                Eq(1));
+    EXPECT_THAT((MakeStream::range(0, 3) | map_(stop_at_1)
+                                          | filter([](int x) { return x != 1; }))
+                    | concat(MakeStream::range(10, 13))
+                    | to_vector(),
+                ElementsAre(0));
+    EXPECT_THAT((MakeStream::range(0, 3) | map_([](int x) {
+                                              if(x == 1) {
+                                                  throw StopStream();
+                                              }
+                                              return x;
+                                          }))
+                    | concat(MakeStream::range(10, 13))
+                    | to_vector(),
+                ElementsAre(0));
+}
+
+TEST(StopTest, Sticky) {
+    int i = 0;
+    auto stream = MakeStream::generate([&]() {
+        if(i == 1) {
+            request_stop();
+        }
+        return i++;
+    });
+    auto& source = stream.getSource();
+    EXPECT_THAT(source->advance(), Eq(true));
+    EXPECT_THAT(source->advance(), Eq(true));
+    EXPECT_THAT(source->value(), Eq(1));
+    EXPECT_THAT(source->advance(), Eq(false));
+    EXPECT_THAT(source->advance(), Eq(false));
+    EXPECT_THAT(i, Eq(2));
+}
+
+TEST(StopTest, ForEach) {
+    std::vector<int> seen;
+    MakeStream::counter(0) | for_each([&](int x) {
+        seen.push_back(x);
+        if(x == 3) {
+            request_stop();
+        }
+    });
+    EXPECT_THAT(seen, ElementsAre(0, 1, 2, 3));
+    EXPECT_THAT(MakeStream::range(0, 3) | count(), Eq(3));
+}
+
+TEST(StopTest, Reduce) {
+    auto sum = MakeStream::counter(1) | identity_reduce(0, [](int total, int x) {
+        if(x == 4) {
+            request_stop();
+        }
+        return total + x;
+    });
+    EXPECT_THAT(sum, Eq(10));
+}
+
+TEST(StopTest, ParallelMap) {
+    exec::ThreadPool pool(3);
+    auto stop_at_500 = [](int x) {
+        if(x == 500) {
+            request_stop();
+        }
+        return x;
+    };
+    auto result = MakeStream::counter(0)
+        | parallel_map(stop_at_500).on(pool)
+        | to_vector();
+    EXPECT_THAT(result.size(), Eq(501));
+    EXPECT_THAT(result.back(), Eq(500));
+    EXPECT_THAT(MakeStream::counter(0)
+                    | parallel_map([](int x) {
+                          if(x == 500) {
+                              throw StopStream();
+                          }
+                          return x;
+                      }).on(pool)
+                    | count(),
+                Eq(500));
+}
+
+TEST(StopTest, ParallelFlatMap) {
+    exec::ThreadPool pool(3);
+    auto result = MakeStream::range(0, 1000)
+        | parallel_flat_map([](int x) {
+              return MakeStream::range(x * 10, x * 10 + 3)
+                  | map_([](int y) {
+                        if(y == 5001) {
+                            request_stop();
+                        }
+                        return y;
+                    });
+          }).on(pool)
+        | to_vector();
+    ASSERT_THAT(result.size(), Eq(1502));
+    EXPECT_THAT(result.back(), Eq(5001));
+}
+
+TEST(StopTest, ParallelReduce) {
+    exec::ThreadPool pool(4);
+    std::vector<int> numbers = MakeStream::range(0, 100000) | to_vector();
+    auto in_stage = MakeStream::from(numbers)
+        | map_([](int x) {
+              if(x == 50000) {
+                  request_stop();
+              }
+              return 1;
+          })
+        | parallel_sum().on(pool);
+    EXPECT_THAT(in_stage, Eq(50001));
+    auto in_accumulator = MakeStream::from(numbers)
+        | parallel_identity_reduce(0, [](int total, int x) {
+              if(x == 50000) {
+                  request_stop();
+              }
+              return total + 1;
+          }, std::plus<int>()).on(pool);
+    EXPECT_THAT(in_accumulator, Eq(50001));
+    auto shared = MakeStream::counter(0)
+        | parallel_identity_reduce(0, [](int total, int x) {
+              if(x == 5000) {
+                  request_stop();
+              }
+              return total + 1;
+          }, std::plus<int>()).on(pool);
+    EXPECT_THAT(shared, Eq(5001));
+}
+
+TEST(StopTest, IncompleteGroup) {
+    EXPECT_THAT(MakeStream::range(0, 7) | group<3>() | count(), Eq(2));
+    EXPECT_THAT(MakeStream::range(0, 2) | overlap<3>() | count(), Eq(0));
+}
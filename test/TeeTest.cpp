@@ -0,0 +1,84 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+TEST(TeeTest, OneAfterAnother) {
+    auto branches = MakeStream::range(0, 5) | tee(3);
+    ASSERT_THAT(branches.size(), Eq(3u));
+    EXPECT_THAT(branches[0] | to_vector(), ElementsAre(0, 1, 2, 3, 4));
+    EXPECT_THAT(branches[1] | map_([](int x) { return x * 2; }) | to_vector(),
+                ElementsAre(0, 2, 4, 6, 8));
+    EXPECT_THAT(branches[2] | sum(), Eq(10));
+}
+
+TEST(TeeTest, Interleaved) {
+    auto branches = MakeStream::from({"a", "b", "c"})
+        | map_([](const char* s) { return std::string(s); })
+        | tee(2);
+    auto& left = branches[0].getSource();
+    auto& right = branches[1].getSource();
+    ASSERT_TRUE(left->advance());
+    EXPECT_THAT(left->value(), Eq("a"));
+    ASSERT_TRUE(left->advance());
+    EXPECT_THAT(left->value(), Eq("b"));
+    ASSERT_TRUE(right->advance());
+    EXPECT_THAT(right->value(), Eq("a"));
+    ASSERT_TRUE(right->advance());
+    EXPECT_THAT(right->value(), Eq("b"));
+    ASSERT_TRUE(right->advance());
+    EXPECT_THAT(right->value(), Eq("c"));
+    ASSERT_TRUE(left->advance());
+    EXPECT_THAT(left->value(), Eq("c"));
+    EXPECT_FALSE(left->advance());
+    EXPECT_FALSE(right->advance());
+}
+
+TEST(TeeTest, DroppedBranch) {
+    auto branches = MakeStream::range(0, 10000) | tee(2);
+    branches[1].close();
+    EXPECT_THAT(branches[0] | count(), Eq(10000));
+}
+
+TEST(TeeTest, Infinite) {
+    auto branches = MakeStream::counter(0) | tee(2);
+    EXPECT_THAT(branches[0] | limit(3) | to_vector(), ElementsAre(0, 1, 2));
+    EXPECT_THAT(branches[1] | limit(4) | to_vector(), ElementsAre(0, 1, 2, 3));
+}
+
+TEST(TeeTest, Concurrent) {
+    auto branches = MakeStream::range(0, 200000)
+        | map_([](int x) { return (long) x; })
+        | tee(3, 64);
+    std::vector<long> sums(3);
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < 3; i++) {
+        threads.emplace_back([&branches, &sums, i] {
+            sums[i] = branches[i] | sum();
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_THAT(sums, Each(Eq(19999900000L)));
+}
+
+TEST(TeeTest, Exception) {
+    auto branches = MakeStream::range(0, 100)
+        | map_([](int x) {
+            if(x == 50) {
+                throw std::runtime_error("source");
+            }
+            return x;
+        })
+        | tee(2);
+    EXPECT_THROW(branches[0] | to_vector(), std::runtime_error);
+    EXPECT_THROW(branches[1] | to_vector(), std::runtime_error);
+}
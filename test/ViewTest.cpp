@@ -0,0 +1,56 @@
+#include <Stream.h>
+
+#include <gmock/gmock.h>
+
+#include <list>
+#include <string>
+
+using namespace testing;
+using namespace stream;
+using namespace stream::op;
+
+TEST(ViewTest, Borrows) {
+    std::vector<std::string> input = {"a", "bb", "ccc"};
+    auto lengths = MakeStream::view(input)
+        | map_([](const std::string& s) { return s.size(); })
+        | to_vector();
+    EXPECT_THAT(lengths, ElementsAre(1, 2, 3));
+    EXPECT_THAT(input, ElementsAre("a", "bb", "ccc"));
+
+    auto head = MakeStream::view(input) | first();
+    EXPECT_THAT(&head.get(), Eq(&input[0]));
+}
+
+TEST(ViewTest, RepeatedPipelines) {
+    std::vector<std::string> input = {"x", "y", "z"};
+    for(int i = 0; i < 3; i++) {
+        auto joined = MakeStream::view(input)
+            | map_([](const std::string& s) { return s; })
+            | sum();
+        EXPECT_THAT(joined, Eq("xyz"));
+    }
+}
+
+TEST(ViewTest, Batches) {
+    std::vector<int> input(3000, 1);
+    EXPECT_THAT(MakeStream::view(input)
+                    | map_([](const int& x) { return x; })
+                    | sum(),
+                Eq(3000));
+    EXPECT_THAT(MakeStream::view(input) | count(), Eq(3000));
+
+    std::list<int> list = {1, 2, 3};
+    auto refs = MakeStream::view(list) | to_vector();
+    EXPECT_THAT(refs.size(), Eq(3));
+    EXPECT_THAT(&refs[2].get(), Eq(&list.back()));
+}
+
+TEST(ViewTest, Seek) {
+    std::vector<int> input = {0, 1, 2, 3, 4, 5, 6};
+    EXPECT_THAT((MakeStream::view(input) | nth(4)).get(), Eq(4));
+    auto strided = MakeStream::view(input)
+        | slice(1, 7, 3)
+        | map_([](const int& x) { return x; })
+        | to_vector();
+    EXPECT_THAT(strided, ElementsAre(1, 4));
+}
@@ -2,6 +2,11 @@
 
 #include <gmock/gmock.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+
 using namespace testing;
 using namespace stream;
 using namespace stream::op;
@@ -43,3 +48,53 @@ TEST(ZipTest, CustomZipper) {
                     | to_vector(),
                 ElementsAre(2, 3, 4, 5, 6));
 }
+
+TEST(ZipTest, Prefetch) {
+    using Z = std::tuple<int, int>;
+    EXPECT_THAT(MakeStream::range(0, 3) | zip_with(MakeStream::range(3, 9), 2) | to_vector(),
+                ElementsAre(Z(0, 3), Z(1, 4), Z(2, 5)));
+    EXPECT_THAT(MakeStream::range(0, 1000)
+                    | zip_with(MakeStream::counter(0), std::plus<int>(), 16)
+                    | sum(),
+                Eq(999000));
+}
+
+TEST(ZipTest, PrefetchOverlaps) {
+    // Each side waits at its second element until the other side gets there
+    // too, which only happens if both run at once. Each side's thread starts
+    // when its first element is pulled, so the first one cannot be the
+    // meeting point. The timeout only keeps a failure from hanging.
+    std::mutex mutex;
+    std::condition_variable arrived;
+    int waiting = 0;
+    bool overlapped = true;
+    auto meet = [&](int x) {
+        if(x == 1) {
+            std::unique_lock<std::mutex> lock(mutex);
+            waiting++;
+            arrived.notify_all();
+            if(!arrived.wait_for(lock, std::chrono::seconds(10),
+                                 [&] { return waiting == 2; })) {
+                overlapped = false;
+            }
+        }
+        return x;
+    };
+    auto result = MakeStream::range(0, 50) | map_(meet)
+        | zip_with(MakeStream::range(0, 50) | map_(meet), std::plus<int>(), 4)
+        | to_vector();
+    EXPECT_THAT(result, SizeIs(50));
+    EXPECT_THAT(result[49], Eq(98));
+    EXPECT_TRUE(overlapped);
+}
+
+TEST(ZipTest, PrefetchException) {
+    auto failing = MakeStream::range(0, 10) | map_([](int x) {
+        if(x == 5) {
+            throw std::runtime_error("right");
+        }
+        return x;
+    });
+    auto zipped = MakeStream::range(0, 10) | zip_with(std::move(failing), 2);
+    EXPECT_THROW(zipped | to_vector(), std::runtime_error);
+}